@@ -0,0 +1,113 @@
+// PingPongOS - PingPong Operating System
+
+// Medição da folga dos despertares: a carga do teste t9 (tarefas que dormem
+// repetidamente) ampliada para milhares de tarefas, cada uma dormindo "cerca
+// de 100 ms", junto de uma tarefa que só processa, sob a política cfs.
+// Informa o número de trocas de contexto, de passagens do dispatcher que
+// acordaram tarefas e a latência dos despertares.
+//
+// uso: bench-slack [tarefas (10000)] [folga em us (0)]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define ROUNDS 5 // vezes que cada tarefa dorme
+
+task_t *sleepers, hog;
+int finished = 0;                   // tarefas que já terminaram
+long slack_us = 0;                  // folga dos despertares
+unsigned long wakes = 0;            // despertares medidos
+unsigned long batches = 0;          // instantes distintos de despertar
+unsigned long long last_wake = 0;   // último instante de despertar (us)
+unsigned long long latency_sum = 0; // soma dos atrasos de despertar (us)
+unsigned long long latency_max = 0; // maior atraso de despertar (us)
+unsigned int seed = 1;              // estado do gerador de números aleatórios
+
+// gerador próprio: random() usa uma trava interna, e uma tarefa preemptada
+// enquanto a detém bloquearia as demais
+int next_random()
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) & 0x7fff;
+}
+
+// dorme ROUNDS vezes entre 95 e 105 ms, medindo o atraso de cada despertar
+void Sleeper(void *arg)
+{
+  unsigned long long wake, latency;
+  int i, sleep;
+
+  task_setslack(NULL, slack_us);
+  for (i = 0; i < ROUNDS; i++)
+  {
+    sleep = 95 + next_random() % 11;
+    wake = systime_us() + sleep * 1000;
+    task_sleep(sleep);
+
+    // as tarefas acordadas na mesma passagem veem o mesmo instante
+    if (systime_us() - last_wake > 100)
+      batches++;
+    last_wake = systime_us();
+
+    latency = (last_wake > wake) ? last_wake - wake : 0;
+    latency_sum += latency;
+    if (latency > latency_max)
+      latency_max = latency;
+    wakes++;
+  }
+  finished++;
+  task_exit(0);
+}
+
+// processa enquanto houver tarefas dormindo
+void Hog(void *arg)
+{
+  int n = *(int *)arg;
+
+  while (finished < n)
+    ;
+  task_exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {.sched_policy = "cfs"};
+  unsigned long switches = 0;
+  int i, n;
+
+  n = (argc > 1) ? atoi(argv[1]) : 10000;
+  slack_us = (argc > 2) ? atol(argv[2]) : 0;
+
+  ppos_init_config(&config);
+
+  sleepers = malloc(n * sizeof(task_t));
+  if (sleepers == NULL)
+  {
+    perror("malloc");
+    exit(1);
+  }
+
+  task_init(&hog, Hog, &n);
+  for (i = 0; i < n; i++)
+    task_init(&sleepers[i], Sleeper, NULL);
+
+  for (i = 0; i < n; i++)
+    task_wait(&sleepers[i]);
+  task_wait(&hog);
+
+  for (i = 0; i < n; i++)
+    switches += sleepers[i].activations;
+  switches += hog.activations;
+
+  printf("bench-slack: %d tarefas, folga %ld us, política %s\n", n, slack_us,
+         config.sched_policy);
+  printf("  despertares %lu em %lu passagens do dispatcher\n", wakes, batches);
+  printf("  trocas de contexto %lu (preempções da tarefa de processamento: %u)\n",
+         switches, hog.activations);
+  printf("  latência dos despertares: média %llu us, máxima %llu us\n",
+         wakes ? latency_sum / wakes : 0, latency_max);
+
+  task_exit(0);
+}
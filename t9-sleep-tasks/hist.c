@@ -0,0 +1,83 @@
+// PingPongOS - PingPong Operating System
+// Histogramas log-lineares (estilo HDR) de durações em nanossegundos
+
+#include <string.h>
+#include "hist.h"
+
+//------------------------------------------------------------------------------
+// Faixa de um valor: os HIST_SUB_BITS bits seguintes ao bit mais
+// significativo escolhem a subdivisão da potência de dois
+
+static int bucket_of(unsigned long long value) {
+    int exp;
+
+    if (value < HIST_SUB) {
+        return value;
+    }
+    exp = 63 - __builtin_clzll(value);
+    if (exp >= HIST_MAX_EXP) {
+        return HIST_BUCKETS - 1;
+    }
+    return (exp - HIST_SUB_BITS + 1) * HIST_SUB +
+           (int) ((value >> (exp - HIST_SUB_BITS)) - HIST_SUB);
+}
+
+//------------------------------------------------------------------------------
+// Maior valor contido na faixa
+
+static unsigned long long bucket_limit(int index) {
+    int exp = index / HIST_SUB + HIST_SUB_BITS - 1;
+    unsigned long long sub = index % HIST_SUB;
+
+    if (index < HIST_SUB) {
+        return index;
+    }
+    return ((HIST_SUB + sub + 1) << (exp - HIST_SUB_BITS)) - 1;
+}
+
+//------------------------------------------------------------------------------
+
+void hist_init(hist_t *hist) {
+    memset(hist, 0, sizeof(hist_t));
+}
+
+//------------------------------------------------------------------------------
+
+void hist_add(hist_t *hist, unsigned long long value) {
+    hist->bucket[bucket_of(value)]++;
+    hist->count++;
+    hist->sum += value;
+    if (value > hist->max) {
+        hist->max = value;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+unsigned long long hist_percentile(const hist_t *hist, double p) {
+    unsigned long long rank, seen = 0, limit;
+    int i;
+
+    if (hist->count == 0) {
+        return 0;
+    }
+
+    // posição da amostra procurada, em ordem crescente (a partir de 1)
+    rank = (unsigned long long) (p / 100.0 * hist->count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > hist->count) {
+        rank = hist->count;
+    }
+
+    for (i = 0; i < HIST_BUCKETS; i++) {
+        seen += hist->bucket[i];
+        if (seen >= rank) {
+            break;
+        }
+    }
+
+    limit = bucket_limit(i);
+    return (limit < hist->max) ? limit : hist->max;
+}
@@ -0,0 +1,42 @@
+// PingPongOS - PingPong Operating System
+// Histogramas log-lineares (estilo HDR) de durações em nanossegundos.
+
+#ifndef __HIST__
+#define __HIST__
+
+//------------------------------------------------------------------------------
+// Cada potência de dois é dividida em HIST_SUB faixas iguais, o que limita o
+// erro relativo de um percentil a 1/HIST_SUB (12,5%). Valores abaixo de
+// HIST_SUB ns têm faixa própria; valores a partir de 2^HIST_MAX_EXP ns
+// (~68 s) ficam na última faixa.
+
+#define HIST_SUB_BITS 3
+#define HIST_SUB (1 << HIST_SUB_BITS)
+#define HIST_MAX_EXP 36
+#define HIST_BUCKETS ((HIST_MAX_EXP - HIST_SUB_BITS + 1) * HIST_SUB)
+
+typedef struct hist_t
+{
+   unsigned long long count ; // número de amostras
+   unsigned long long sum ;   // soma das amostras (ns)
+   unsigned long long max ;   // maior amostra (ns)
+   unsigned int bucket[HIST_BUCKETS] ;
+} hist_t ;
+
+//------------------------------------------------------------------------------
+// Zera o histograma.
+
+void hist_init (hist_t *hist) ;
+
+//------------------------------------------------------------------------------
+// Acrescenta uma amostra (em ns). Custo O(1).
+
+void hist_add (hist_t *hist, unsigned long long value) ;
+
+//------------------------------------------------------------------------------
+// Retorna o percentil p (0 a 100) das amostras, em ns: o limite superior da
+// faixa que o contém, limitado à maior amostra (0 se não há amostras).
+
+unsigned long long hist_percentile (const hist_t *hist, double p) ;
+
+#endif
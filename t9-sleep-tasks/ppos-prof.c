@@ -0,0 +1,244 @@
+// PingPongOS - PingPong Operating System
+
+// Simboliza as amostras salvas pelo perfil de CPU (PPOS_PROFILE) e produz
+// pilhas no formato "folded" (uma linha por pilha distinta, com o número de
+// amostras), separadas por tarefa: a raiz de cada pilha é "task N". A saída
+// alimenta ferramentas de gráficos de chama (flamegraph.pl, speedscope).
+// Os endereços são simbolizados com addr2line.
+//
+// uso: ppos-prof <amostras> [tarefa]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ppos_prof.h"
+
+#define MAX_MODULES 32
+#define LINE_SIZE 4096
+
+// um endereço amostrado e seu nome
+typedef struct
+{
+  unsigned long offset;
+  char *name;
+} symbol_t;
+
+// módulo (executável ou biblioteca) e seus endereços amostrados
+typedef struct
+{
+  char *path;
+  symbol_t *symbols;
+  int count, size;
+} module_t;
+
+// quadro de uma amostra: módulo (-1: desconhecido) e deslocamento
+typedef struct
+{
+  int module;
+  unsigned long offset;
+} frame_t;
+
+typedef struct
+{
+  int task;
+  int depth;
+  frame_t frames[PROF_DEPTH];
+} sample_t;
+
+static module_t modules[MAX_MODULES];
+static sample_t *samples = NULL;
+static int nsamples = 0;
+
+static int symbol_cmp(const void *a, const void *b)
+{
+  unsigned long x = ((const symbol_t *)a)->offset, y = ((const symbol_t *)b)->offset;
+
+  return (x > y) - (x < y);
+}
+
+static int string_cmp(const void *a, const void *b)
+{
+  return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// acrescenta um endereço ao módulo (repetidos são eliminados depois)
+static void add_symbol(module_t *module, unsigned long offset)
+{
+  if (module->count == module->size)
+  {
+    module->size = module->size ? 2 * module->size : 256;
+    module->symbols = realloc(module->symbols, module->size * sizeof(symbol_t));
+  }
+  module->symbols[module->count].offset = offset;
+  module->symbols[module->count].name = NULL;
+  module->count++;
+}
+
+// simboliza os endereços do módulo com addr2line; os que ele não resolve
+// ficam como "módulo+deslocamento"
+static void symbolize(module_t *module)
+{
+  char tmp[] = "/tmp/ppos-prof-XXXXXX", line[LINE_SIZE], command[LINE_SIZE + 64];
+  const char *base;
+  FILE *file, *pipe = NULL;
+  int fd, i, n = 0;
+
+  // elimina os endereços repetidos
+  qsort(module->symbols, module->count, sizeof(symbol_t), symbol_cmp);
+  for (i = 0; i < module->count; i++)
+    if (n == 0 || module->symbols[i].offset != module->symbols[n - 1].offset)
+      module->symbols[n++] = module->symbols[i];
+  module->count = n;
+
+  // módulos sem arquivo (como o vdso) não são simbolizados
+  if (access(module->path, R_OK) == 0 && (fd = mkstemp(tmp)) >= 0 &&
+      (file = fdopen(fd, "w")) != NULL)
+  {
+    for (i = 0; i < module->count; i++)
+      fprintf(file, "0x%lx\n", module->symbols[i].offset);
+    fclose(file);
+    snprintf(command, sizeof(command), "addr2line -f -e '%s' < %s", module->path, tmp);
+    pipe = popen(command, "r");
+  }
+
+  base = strrchr(module->path, '/') ? strrchr(module->path, '/') + 1 : module->path;
+  for (i = 0; i < module->count; i++)
+  {
+    // addr2line escreve duas linhas por endereço: função e arquivo:linha
+    if (pipe != NULL && fgets(line, sizeof(line), pipe) != NULL)
+    {
+      line[strcspn(line, "\n")] = '\0';
+      if (strcmp(line, "??") != 0)
+        module->symbols[i].name = strdup(line);
+      if (fgets(line, sizeof(line), pipe) == NULL)
+        line[0] = '\0';
+    }
+    if (module->symbols[i].name == NULL)
+    {
+      snprintf(line, sizeof(line), "%s+0x%lx", base, module->symbols[i].offset);
+      module->symbols[i].name = strdup(line);
+    }
+  }
+
+  if (pipe != NULL)
+  {
+    pclose(pipe);
+    unlink(tmp);
+  }
+}
+
+// nome do quadro
+static const char *frame_name(frame_t *frame)
+{
+  module_t *module;
+  symbol_t key, *symbol;
+
+  if (frame->module < 0)
+    return "?";
+
+  module = &modules[frame->module];
+  key.offset = frame->offset;
+  symbol = bsearch(&key, module->symbols, module->count, sizeof(symbol_t), symbol_cmp);
+  return symbol ? symbol->name : "?";
+}
+
+// lê o arquivo de amostras
+static void load(const char *path)
+{
+  char line[LINE_SIZE], *token, *rest;
+  int index, size = 0;
+  FILE *file;
+
+  if ((file = fopen(path, "r")) == NULL)
+  {
+    perror(path);
+    exit(1);
+  }
+  if (fgets(line, sizeof(line), file) == NULL || strncmp(line, "ppos-profile 1", 14) != 0)
+  {
+    fprintf(stderr, "%s: arquivo de amostras invalido\n", path);
+    exit(1);
+  }
+
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    line[strcspn(line, "\n")] = '\0';
+
+    if (sscanf(line, "module %d", &index) == 1 && index >= 0 && index < MAX_MODULES)
+      modules[index].path = strdup(strchr(line + 7, ' ') + 1);
+
+    else if (strncmp(line, "sample ", 7) == 0)
+    {
+      sample_t *sample;
+
+      if (nsamples == size)
+      {
+        size = size ? 2 * size : 1024;
+        samples = realloc(samples, size * sizeof(sample_t));
+      }
+      sample = &samples[nsamples++];
+      sample->task = strtol(line + 7, &rest, 10);
+      sample->depth = 0;
+
+      // quadros "módulo:deslocamento" ou "?"
+      for (token = strtok(rest, " "); token != NULL && sample->depth < PROF_DEPTH;
+           token = strtok(NULL, " "))
+      {
+        frame_t *frame = &sample->frames[sample->depth++];
+
+        if (sscanf(token, "%d:%lx", &frame->module, &frame->offset) != 2 ||
+            frame->module < 0 || frame->module >= MAX_MODULES || modules[frame->module].path == NULL)
+          frame->module = -1;
+        else
+          add_symbol(&modules[frame->module], frame->offset);
+      }
+    }
+    else if (strncmp(line, "period", 6) == 0)
+      fprintf(stderr, "%s: %s\n", path, line);
+  }
+  fclose(file);
+}
+
+int main(int argc, char *argv[])
+{
+  char **stacks, buffer[LINE_SIZE];
+  int i, j, n = 0, count, task = -1, len;
+
+  if (argc < 2)
+  {
+    fprintf(stderr, "uso: %s <amostras> [tarefa]\n", argv[0]);
+    exit(1);
+  }
+  if (argc > 2)
+    task = atoi(argv[2]);
+
+  load(argv[1]);
+  for (i = 0; i < MAX_MODULES; i++)
+    if (modules[i].path != NULL && modules[i].count > 0)
+      symbolize(&modules[i]);
+
+  // uma pilha por amostra, da raiz (a tarefa) para o ponto interrompido
+  stacks = malloc((nsamples + 1) * sizeof(char *));
+  for (i = 0; i < nsamples; i++)
+  {
+    if (task >= 0 && samples[i].task != task)
+      continue;
+
+    len = snprintf(buffer, sizeof(buffer), "task %d", samples[i].task);
+    for (j = samples[i].depth - 1; j >= 0 && len < (int)sizeof(buffer); j--)
+      len += snprintf(buffer + len, sizeof(buffer) - len, ";%s", frame_name(&samples[i].frames[j]));
+    stacks[n++] = strdup(buffer);
+  }
+
+  // pilhas iguais são contadas juntas
+  qsort(stacks, n, sizeof(char *), string_cmp);
+  for (i = 0; i < n; i += count)
+  {
+    for (count = 1; i + count < n && strcmp(stacks[i], stacks[i + count]) == 0; count++)
+      ;
+    printf("%s %d\n", stacks[i], count);
+  }
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+// PingPongOS - PingPong Operating System
+
+// Monitor externo das estatísticas que um processo PingPongOS publica em
+// memória compartilhada (PPOS_STATS_FILE). Mapeia o arquivo somente para
+// leitura e mostra, a cada intervalo, o uso de CPU, o estado e a prioridade
+// de cada tarefa e o tamanho das filas, sem interferir no processo.
+//
+// uso: ppos-top <arquivo> [intervalo em ms (1000)] [atualizações (0: até o fim do processo)]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "ppos_shm.h"
+
+static stats_shm_t snap;                    // cópia consistente atual
+static unsigned long long prev_run[STATS_MAX_TASKS]; // tempo em execução anterior, por posição
+static int prev_id[STATS_MAX_TASKS];        // tarefa da posição na cópia anterior
+static int prev_count = 0;
+static unsigned long long prev_uptime = 0;
+
+// copia a região compartilhada respeitando o seqlock
+static void read_snapshot(const stats_shm_t *shm)
+{
+  unsigned int seq;
+
+  do
+  {
+    while ((seq = shm->seq) & 1)
+      usleep(100);
+    __sync_synchronize();
+    memcpy(&snap, (const void *)shm, sizeof(snap));
+    __sync_synchronize();
+  } while (shm->seq != seq);
+}
+
+// tempo em execução da tarefa na cópia anterior (0 se ela não aparecia)
+static unsigned long long previous_run(int index, int id)
+{
+  int i;
+
+  if (index < prev_count && prev_id[index] == id)
+    return prev_run[index];
+  for (i = 0; i < prev_count; i++)
+    if (prev_id[i] == id)
+      return prev_run[i];
+  return 0;
+}
+
+static const char *status_name(int status)
+{
+  switch (status)
+  {
+  case TASK_READY:
+    return "ready";
+  case TASK_RUNNING:
+    return "running";
+  case TASK_SUSPENDED:
+    return "suspended";
+  case TASK_TERMINATED:
+    return "terminated";
+  default:
+    return "?";
+  }
+}
+
+// mostra a cópia atual; o uso de CPU é medido desde a anterior
+static void show(int clear)
+{
+  unsigned long long elapsed = snap.sys.uptime_ns - prev_uptime;
+  unsigned long long busy = snap.sys.user_ns + snap.sys.kernel_ns;
+  int i;
+
+  if (clear)
+    printf("\033[H\033[2J");
+  printf("ppos-top: pid %d, uptime %llu ms, %d tarefas (%d prontas, %d adormecidas), quantum %d\n",
+         snap.pid, snap.sys.uptime_ns / 1000000, snap.sys.tasks, snap.sys.ready,
+         snap.sys.sleeping, snap.sys.quantum);
+  printf("trocas %llu (%lu/s), ticks %llu, ocioso %.1f%%\n", snap.sys.switches,
+         snap.sys.switch_rate, snap.sys.ticks,
+         (busy + snap.sys.idle_ns) ? 100.0 * snap.sys.idle_ns / (busy + snap.sys.idle_ns) : 0.0);
+  printf("%6s %-10s %5s %5s %6s %10s %8s %8s %8s %8s\n", "TASK", "STATE", "PRIO", "DYN",
+         "CPU%", "CPU(ms)", "ACT", "INVOL", "SLEEPS", "THROTTLE");
+
+  for (i = 0; i < snap.ntasks; i++)
+  {
+    task_stats_t *t = &snap.tasks[i];
+    unsigned long long run = t->run_ns - previous_run(i, t->id);
+
+    printf("%6d %-10s %5d %5d %5.1f%% %10llu %8u %8u %8u %8u\n", t->id,
+           status_name(t->status), t->static_prio, t->dynamic_prio,
+           elapsed ? 100.0 * run / elapsed : 0.0, t->run_ns / 1000000, t->activations,
+           t->involuntary, t->sleeps, t->throttles);
+  }
+  if (snap.sys.tasks > snap.ntasks)
+    printf("(%d tarefas omitidas)\n", snap.sys.tasks - snap.ntasks);
+
+  for (i = 0; i < snap.ntasks; i++)
+  {
+    prev_id[i] = snap.tasks[i].id;
+    prev_run[i] = snap.tasks[i].run_ns;
+  }
+  prev_count = snap.ntasks;
+  prev_uptime = snap.sys.uptime_ns;
+}
+
+int main(int argc, char *argv[])
+{
+  const stats_shm_t *shm;
+  int fd, interval, count, n = 0;
+
+  if (argc < 2)
+  {
+    fprintf(stderr, "uso: %s <arquivo> [intervalo ms] [atualizacoes]\n", argv[0]);
+    exit(1);
+  }
+  interval = (argc > 2) ? atoi(argv[2]) : 1000;
+  count = (argc > 3) ? atoi(argv[3]) : 0;
+
+  if ((fd = open(argv[1], O_RDONLY)) < 0)
+  {
+    perror(argv[1]);
+    exit(1);
+  }
+  shm = mmap(NULL, sizeof(stats_shm_t), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (shm == MAP_FAILED)
+  {
+    perror(argv[1]);
+    exit(1);
+  }
+  if (memcmp(shm->magic, STATS_MAGIC, 4) != 0 || shm->version != STATS_VERSION)
+  {
+    fprintf(stderr, "%s: arquivo de estatisticas invalido\n", argv[1]);
+    exit(1);
+  }
+
+  // atualiza até o número pedido de vezes ou até o processo terminar
+  while (count == 0 || n < count)
+  {
+    read_snapshot(shm);
+    show(isatty(STDOUT_FILENO));
+    n++;
+    if (kill(shm->pid, 0) < 0 && errno == ESRCH)
+      break;
+    usleep(interval * 1000);
+  }
+
+  return 0;
+}
@@ -0,0 +1,159 @@
+// PingPongOS - PingPong Operating System
+
+// Converte um registro de eventos salvo por trace_dump() (ou por PPOS_TRACE)
+// para o formato JSON de eventos do Chrome, que pode ser aberto em
+// chrome://tracing ou no Perfetto. Cada tarefa vira uma linha do tempo: os
+// intervalos em que ela ocupou a CPU são eventos completos ("X") e os demais
+// eventos são instantâneos ("i").
+//
+// uso: ppos-trace <registro> [saída.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ppos_trace.h"
+
+static FILE *out;
+static int first_event = 1;
+
+// nomes dos eventos instantâneos, por tipo
+static const char *event_name(int type)
+{
+  switch (type)
+  {
+  case TRACE_SUSPEND:
+    return "suspend";
+  case TRACE_WAKE:
+    return "wake";
+  case TRACE_SLEEP:
+    return "sleep";
+  case TRACE_WAKEUP:
+    return "wakeup";
+  case TRACE_PREEMPT:
+    return "preempt";
+  case TRACE_EXIT:
+    return "exit";
+  case TRACE_THROTTLE:
+    return "throttle";
+  default:
+    return "unknown";
+  }
+}
+
+// inicia um evento JSON, separando-o do anterior
+static void begin_event()
+{
+  fprintf(out, first_event ? "\n" : ",\n");
+  first_event = 0;
+}
+
+// intervalo em que a tarefa ocupou a CPU
+static void emit_run(int task, unsigned long long start, unsigned long long end)
+{
+  begin_event();
+  fprintf(out, "{\"name\":\"run\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+               "\"ts\":%.3f,\"dur\":%.3f}",
+          task, start / 1000.0, (end - start) / 1000.0);
+}
+
+// evento instantâneo da tarefa
+static void emit_instant(trace_record_t *rec)
+{
+  begin_event();
+  fprintf(out, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,"
+               "\"ts\":%.3f,\"args\":{\"arg\":%lld}}",
+          event_name(rec->type), rec->task, rec->time / 1000.0, rec->arg);
+}
+
+// nome da linha do tempo da tarefa
+static void emit_name(int task)
+{
+  begin_event();
+  fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+               "\"args\":{\"name\":\"task %d\"}}",
+          task, task);
+}
+
+int main(int argc, char *argv[])
+{
+  trace_header_t header;
+  trace_record_t rec;
+  unsigned long long run_start = 0, last_time = 0;
+  unsigned char *seen = NULL;
+  int running = -1, max_task = -1, n;
+  unsigned int i;
+  FILE *in;
+
+  if (argc < 2)
+  {
+    fprintf(stderr, "uso: %s <registro> [saida.json]\n", argv[0]);
+    exit(1);
+  }
+
+  if ((in = fopen(argv[1], "rb")) == NULL)
+  {
+    perror(argv[1]);
+    exit(1);
+  }
+  if (fread(&header, sizeof(header), 1, in) != 1 ||
+      memcmp(header.magic, TRACE_MAGIC, 4) != 0 || header.version != TRACE_VERSION)
+  {
+    fprintf(stderr, "%s: registro invalido\n", argv[1]);
+    exit(1);
+  }
+
+  out = stdout;
+  if (argc > 2 && (out = fopen(argv[2], "w")) == NULL)
+  {
+    perror(argv[2]);
+    exit(1);
+  }
+
+  fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  for (i = 0; i < header.count && fread(&rec, sizeof(rec), 1, in) == 1; i++)
+  {
+    // nomeia cada tarefa na primeira vez em que aparece
+    n = (rec.type == TRACE_SWITCH && rec.arg > rec.task) ? rec.arg : rec.task;
+    if (n > max_task)
+    {
+      seen = realloc(seen, n + 1);
+      memset(seen + max_task + 1, 0, n - max_task);
+      max_task = n;
+    }
+    if (!seen[rec.task])
+    {
+      seen[rec.task] = 1;
+      emit_name(rec.task);
+    }
+
+    if (rec.type == TRACE_SWITCH)
+    {
+      // fecha o intervalo da tarefa que sai (desconhecido no início do anel)
+      if (running == rec.task)
+        emit_run(running, run_start, rec.time);
+      running = rec.arg;
+      run_start = rec.time;
+      if (!seen[running])
+      {
+        seen[running] = 1;
+        emit_name(running);
+      }
+    }
+    else
+      emit_instant(&rec);
+    last_time = rec.time;
+  }
+
+  // a tarefa que executava quando o registro foi salvo
+  if (running >= 0 && last_time > run_start)
+    emit_run(running, run_start, last_time);
+  fprintf(out, "\n]}\n");
+
+  if (header.lost > 0)
+    fprintf(stderr, "%s: %u eventos anteriores foram sobrescritos no anel\n",
+            argv[1], header.lost);
+
+  free(seen);
+  fclose(in);
+  return 0;
+}
@@ -0,0 +1,79 @@
+// PingPongOS - PingPong Operating System
+
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+#include "ppos_clock.h"
+
+// Relógio monotônico do hospedeiro, em nanossegundos
+unsigned long long clock_ns()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Tempo de CPU consumido pelo processo hospedeiro, em nanossegundos
+unsigned long long clock_cpu_ns()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Suspende o processo hospedeiro até o instante indicado (ou até um sinal)
+void clock_sleep_until(unsigned long long ns)
+{
+  struct timespec ts;
+
+  ts.tv_sec = ns / 1000000000ULL;
+  ts.tv_nsec = ns % 1000000000ULL;
+  clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+// Cria um timerfd periódico (não bloqueante) no relógio monotônico
+int clock_tick_open(unsigned long long interval_ns)
+{
+  struct itimerspec its;
+  int fd;
+
+  fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (fd < 0)
+    return -1;
+
+  its.it_interval.tv_sec = interval_ns / 1000000000ULL;
+  its.it_interval.tv_nsec = interval_ns % 1000000000ULL;
+  its.it_value = its.it_interval;
+  if (timerfd_settime(fd, 0, &its, NULL) < 0)
+  {
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+// Retorna as expirações do timerfd desde a última leitura, sem bloquear
+unsigned long long clock_tick_read(int fd)
+{
+  unsigned long long ticks;
+
+  if (read(fd, &ticks, sizeof(ticks)) != sizeof(ticks))
+    return 0;
+  return ticks;
+}
+
+// Bloqueia até a próxima expiração do timerfd (ou até um sinal) e retorna as
+// expirações desde a última leitura
+unsigned long long clock_tick_wait(int fd)
+{
+  struct pollfd pfd;
+
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+  poll(&pfd, 1, -1);
+  return clock_tick_read(fd);
+}
@@ -0,0 +1,29 @@
+// PingPongOS - PingPong Operating System
+
+// Acesso do núcleo aos relógios do sistema hospedeiro. Fica num módulo
+// separado porque ppos.h proíbe essas chamadas no código das tarefas.
+
+#ifndef __PPOS_CLOCK__
+#define __PPOS_CLOCK__
+
+// relógio monotônico do hospedeiro, em nanossegundos
+unsigned long long clock_ns();
+
+// tempo de CPU consumido pelo processo hospedeiro, em nanossegundos
+unsigned long long clock_cpu_ns();
+
+// suspende o processo hospedeiro até o instante "ns" do relógio monotônico,
+// ou até a chegada de um sinal
+void clock_sleep_until(unsigned long long ns);
+
+// cria um timerfd que expira a cada interval_ns; retorna o descritor ou -1
+int clock_tick_open(unsigned long long interval_ns);
+
+// expirações do timerfd desde a última leitura (não bloqueia)
+unsigned long long clock_tick_read(int fd);
+
+// bloqueia até a próxima expiração do timerfd (ou até um sinal) e retorna
+// as expirações desde a última leitura
+unsigned long long clock_tick_wait(int fd);
+
+#endif
@@ -1,29 +1,75 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <ucontext.h>
 #include <signal.h>
 #include <sys/time.h>
 #include "ppos.h"
 #include "ppos_data.h"
+#include "ppos_ext.h"
+#include "ppos_sched.h"
+#include "ppos_clock.h"
+#include "ppos_trace.h"
+#include "ppos_prof.h"
+#include "ppos_offcpu.h"
+#include "ppos_perf.h"
+#include "ppos_probe.h"
+#include "ppos_lockstat.h"
 #include "queue.h"
 
 #define STACKSIZE 64 * 1024 // 64KB por tarefa
-#define DEFAULT_PRIO 0      // Prioridade padrão
-#define ALPHA -1            // Fator de envelhecimento
-#define MIN_PRIO -20        // Prioridade máxima
-#define MAX_PRIO 20         // Prioridade mínima
-#define QUANTUM 20          // Quantum padrão (em ticks)
-#define TICK_INTERVAL 1000  // Intervalo do temporizador (em microssegundos)
+#define SLICE_EXTENSION 1   // Ticks de extensão concedidos a uma seção crítica
+#define OVERHEAD_RATIO 20   // O quantum vale ao menos 20 trocas (custo de troca <= 5%)
+#define NO_WAKE (~0ULL)     // Nenhuma tarefa adormecida
+
+// Classes de escalonamento, em ordem de precedência
+#define CLASS_DL 0     // Tarefas EDF
+#define CLASS_RT 1     // Tarefas FIFO e RR
+#define CLASS_NORMAL 2 // Tarefas normais, com a política escolhida na inicialização
+#define NUM_CLASSES 3
 
 // Variáveis globais do sistema
 static task_t *current_task = NULL;   // Tarefa atual
 static task_t main_task;              // Tarefa principal
 static task_t dispatcher_task;        // Tarefa dispatcher
 static int task_counter = 0;          // Contador de IDs
-static queue_t *ready_queue = NULL;   // Fila de tarefas prontas
-static task_t *sleeping_queue = NULL; // Fila de tarefas adormecidas
+static task_t *all_tasks = NULL;      // Lista de todas as tarefas existentes
+static int all_count = 0;             // Número de tarefas existentes
+static rb_tree_t sleep_tree;          // Tarefas adormecidas, em ordem de wake_time
+static int sleeping_count = 0;        // Número de tarefas adormecidas
 static int user_tasks_count = 0;      // Contador de tarefas de usuário
-static unsigned int system_clock = 0; // Relógio do sistema
+static unsigned long long boot_time = 0; // Relógio monotônico na inicialização (ns)
+static unsigned long long next_wake = NO_WAKE; // Próximo despertar de tarefa adormecida (ns)
+static volatile int preempt_count = 0;         // > 0: a tarefa atual não pode ser preemptada
+static int tick_fd = -1;                       // timerfd dos ticks (-1: sinal periódico)
+static int tick_timer = ITIMER_REAL;           // Relógio dos ticks: real, virtual ou prof
+static int tick_signal = SIGALRM;              // Sinal gerado pelo relógio dos ticks
+static unsigned long long switch_time = 0;     // Relógio monotônico na última medição (ns)
+static unsigned long long switch_cpu = 0;      // Tempo de CPU do processo na última medição (ns)
+static unsigned long long user_ns = 0;         // Tempo total em tarefas de usuário
+static unsigned long long kernel_ns = 0;       // Tempo total no dispatcher
+static unsigned long long idle_ns = 0;         // Tempo total sem tarefas prontas
+static unsigned long long switch_count = 0;    // Trocas de contexto desde a inicialização
+static unsigned long long tick_count = 0;      // Ticks desde a inicialização
+static stats_rate_t snapshot_rate;            // Referência da taxa de trocas dos snapshots
+
+// Latências de escalonamento de todas as tarefas (em ns)
+static hist_t wait_hist;     // Espera entre ficar pronta e executar
+static hist_t wakeup_hist;   // Espera entre acordar e executar
+static hist_t decision_hist; // Duração das escolhas do escalonador
+static unsigned long long tick_cpu = 0;        // Tempo de CPU já convertido em ticks (ns)
+
+// Política de cada classe de escalonamento (a da classe normal é configurável)
+static sched_policy_t *sched_classes[NUM_CLASSES] = {&sched_dl, &sched_rt, &sched_prio};
+
+// Número de tarefas prontas em cada classe
+static int ready_count[NUM_CLASSES];
+
+// Ajuste automático do quantum (desligado se target_latency == 0)
+static int target_latency = 0;               // Latência de escalonamento alvo (ms)
+static int min_granularity = 1;              // Quantum mínimo (ticks)
+static unsigned long switch_overhead_ns = 0; // Custo médio de uma decisão do dispatcher
+static unsigned long quantum_updates = 0;    // Número de mudanças do quantum
 
 // Estrutura para o tratador de sinal
 struct sigaction action;
@@ -31,35 +77,349 @@ struct sigaction action;
 // Estrutura para o temporizador
 struct itimerval timer;
 
-// Variável para controlar o quantum da tarefa atual
-static int task_quantum;
+// Retorna a classe de escalonamento à qual a tarefa pertence
+static int class_index(task_t *task)
+{
+  switch (task->sched_class)
+  {
+  case SCHED_CLASS_DEADLINE:
+    return CLASS_DL;
+  case SCHED_CLASS_FIFO:
+  case SCHED_CLASS_RR:
+    return CLASS_RT;
+  default:
+    return CLASS_NORMAL;
+  }
+}
+
+// Verifica se há tarefa pronta em classe de precedência maior que a da tarefa
+static int higher_class_ready(task_t *task)
+{
+  for (int i = 0; i < class_index(task); i++)
+    if (ready_count[i] > 0)
+      return 1;
+
+  return 0;
+}
+
+// Número de tarefas prontas, em todas as classes
+static inline int ready_total()
+{
+  int ready = 0;
+
+  for (int i = 0; i < NUM_CLASSES; i++)
+    ready += ready_count[i];
+
+  return ready;
+}
+
+// Decide se a tarefa pode adiar a preempção por estar em seção crítica curta;
+// retorna a decisão final de preempção
+static int slice_extension(task_t *task, int preempt)
+{
+  // Com os relógios de CPU um sinal pode cobrar vários ticks: a extensão
+  // não teria limite
+  if (tick_timer != ITIMER_REAL)
+    return preempt;
+
+  // Extensão em curso: a tarefa ainda não liberou a CPU
+  if (task->cs_pending)
+  {
+    // Saiu da seção crítica desligando cs_flag diretamente, sem
+    // task_cs_end(): a preempção adiada acontece agora, sem abuso
+    if (!task->cs_flag)
+    {
+      task->cs_pending = 0;
+      return 1;
+    }
+
+    // Extensão esgotada ainda na seção crítica: abuso, preempção forçada
+    if (--task->cs_ext_left <= 0)
+    {
+      task->cs_pending = 0;
+      task->cs_abuses++;
+      return 1;
+    }
+    return 0;
+  }
+
+  // A fatia acabou durante a seção crítica: concede a extensão
+  if (preempt && task->cs_flag)
+  {
+    task->cs_pending = 1;
+    task->cs_ext_left = SLICE_EXTENSION;
+    task->cs_extensions++;
+    return 0;
+  }
+
+  return preempt;
+}
+
+// Registra o motivo, o objeto e o local de um bloqueio que pode começar,
+// a menos que uma chamada mais externa já o tenha feito
+static void block_mark(int reason, void *object, void *site)
+{
+  if (offcpu_enabled && current_task->block_site == NULL)
+  {
+    current_task->block_reason = reason;
+    current_task->block_object = object;
+    current_task->block_site = site;
+    current_task->block_start = 0;
+  }
+}
+
+// Marca um bloqueio das primitivas de sincronização
+void task_block_mark(int reason, void *object, void *site)
+{
+  block_mark(reason, object, site);
+}
+
+// O bloqueio marcado começa (a tarefa vai deixar a CPU)
+static void block_begin()
+{
+  if (current_task->block_site != NULL)
+    current_task->block_start = systime_ns();
+}
+
+// A tarefa voltou a executar: registra a duração do bloqueio marcado, se
+// ele chegou a acontecer
+static void block_end()
+{
+  task_t *task = current_task;
+
+  if (task->block_site == NULL)
+    return;
+
+  if (task->block_start != 0)
+  {
+    preempt_disable();
+    offcpu_record(task->block_reason, task->block_object, task->block_site,
+                  systime_ns() - task->block_start);
+    preempt_enable();
+  }
+  task->block_site = NULL;
+}
+
+// Ordena as tarefas adormecidas pelo momento de acordar
+static int wake_less(const rb_node_t *a, const rb_node_t *b)
+{
+  return rb_entry(a, task_t, rb_node)->wake_time < rb_entry(b, task_t, rb_node)->wake_time;
+}
+
+// Adormece uma tarefa até seu wake_time
+static void sleep_insert(task_t *task)
+{
+  task->status = TASK_SUSPENDED;
+  rb_insert(&sleep_tree, &task->rb_node, wake_less);
+  sleeping_count++;
+  if (task->wake_time < next_wake)
+    next_wake = task->wake_time;
+}
+
+// Adormece a tarefa atual até seu wake_time e volta ao dispatcher
+static void sleep_current()
+{
+  preempt_disable();
+  current_task->sleeps++;
+  sleep_insert(current_task);
+  TRACE(TRACE_SLEEP, current_task->id, current_task->wake_time);
+  PROBE3(task__sleep, current_task->id, current_task->wake_time, sleeping_count);
+  preempt_enable();
+  block_begin();
+  task_switch(&dispatcher_task);
+  block_end();
+}
+
+// Contém uma tarefa que esgotou o orçamento EDF ou a cota de um grupo até seu
+// wake_time; não é um adormecimento voluntário, por isso é contado à parte
+static void throttle_insert(task_t *task)
+{
+  task->throttles++;
+  sleep_insert(task);
+  TRACE(TRACE_THROTTLE, task->id, task->wake_time);
+  PROBE3(task__throttle, task->id, task->wake_time, sleeping_count);
+}
+
+// Contém a tarefa atual e volta ao dispatcher
+static void throttle_current()
+{
+  preempt_disable();
+  throttle_insert(current_task);
+  preempt_enable();
+  task_switch(&dispatcher_task);
+}
+
+// Cobra da tarefa o tempo desde a última medição, no relógio monotônico e
+// no tempo de CPU do processo; o tempo de processador em ms deriva dele.
+// Chamada com a preempção desabilitada, nas trocas de contexto.
+static void account(task_t *task)
+{
+  unsigned long long now = clock_ns(), cpu = clock_cpu_ns();
+  unsigned long long delta = now - switch_time;
+
+  task->run_ns += delta;
+  task->processor_time = task->run_ns / NS_PER_MS;
+  task->cpu_ns += cpu - switch_cpu;
+  perf_account(task->perf);
+  if (task->task_type == USER_TASK)
+    user_ns += delta;
+  else
+    kernel_ns += delta;
+
+  switch_time = now;
+  switch_cpu = cpu;
+}
+
+// Contabiliza como ocioso o tempo desde a última medição (o dispatcher
+// esperou sem tarefas prontas)
+static void account_idle()
+{
+  unsigned long long now = clock_ns();
+
+  idle_ns += now - switch_time;
+  switch_time = now;
+  switch_cpu = clock_cpu_ns();
+  perf_account(NULL);
+}
+
+// Cobra "ticks" ticks de CPU da tarefa; retorna a decisão (SCHED_*) da
+// política e dos grupos
+static int charge_ticks(task_t *task, unsigned long long ticks)
+{
+  int decision = SCHED_CONTINUE, d;
+  task_group_t *group;
+
+  while (ticks-- > 0 && decision != SCHED_THROTTLE)
+  {
+    // A política da classe decide se a fatia de tempo (ou o orçamento) se
+    // esgotou
+    d = sched_classes[class_index(task)]->tick(task);
+    if (d > decision)
+      decision = d;
+
+    // Cobra o tick nos grupos da tarefa
+    group_charge(task, systime_ns());
+  }
+
+  // Se algum grupo esgotou a cota, a tarefa fica bloqueada até o fim do
+  // período desse grupo
+  if ((group = group_throttled(task, systime_ns())) != NULL)
+  {
+    task->wake_time = group->period_start + group->period * NS_PER_MS;
+    decision = SCHED_THROTTLE;
+  }
+
+  return decision;
+}
+
+// Arma o aviso de preempção do modo timerfd para daqui a "ticks" ticks
+// (0 desarma)
+static void tick_nudge(int ticks)
+{
+  struct itimerval nudge;
+
+  nudge.it_value.tv_sec = (ticks * TICK_INTERVAL) / 1000000;
+  nudge.it_value.tv_usec = (ticks * TICK_INTERVAL) % 1000000;
+  nudge.it_interval.tv_sec = 0;
+  nudge.it_interval.tv_usec = 0;
+  setitimer(tick_timer, &nudge, 0);
+}
+
+// Ticks até o próximo ponto em que a tarefa pode perder a CPU: fim da fatia,
+// fim da cota de um de seus grupos, próximo despertar ou próximo temporizador
+// (modo timerfd)
+static int nudge_ticks(task_t *task)
+{
+  unsigned long long now = systime_ns();
+  int ticks = task->slice;
+  int quota = group_quota_ticks(task, now);
+
+  // Orçamentos EDF e políticas sem fatia são verificados a cada tick
+  if (class_index(task) == CLASS_DL || ticks < 1)
+    ticks = 1;
+  if (ticks > sched_quantum)
+    ticks = sched_quantum;
+  if (quota >= 0 && quota < ticks)
+    ticks = (quota > 0) ? quota : 1;
+  if (next_wake != NO_WAKE && next_wake < now + ticks * TICK_NS)
+    ticks = (next_wake > now) ? (next_wake - now + TICK_NS - 1) / TICK_NS : 1;
+  if (ticks > 1 && ktimer_due(now / NS_PER_MS + ticks))
+    ticks = 1;
+
+  return ticks;
+}
 
-// Tratador de sinal para preempção
+// Tratador de sinal para preempção. No modo "timerfd" o sinal é só um aviso,
+// armado pelo dispatcher para o fim da fatia da tarefa: os ticks vêm do
+// timerfd e são cobrados todos de uma vez.
 void timer_handler(int signum)
 {
-  // Incrementa o relógio do sistema
-  system_clock++;
+  unsigned long long ticks = 1;
 
   // Se existe tarefa atual
   if (current_task)
   {
-    // Incrementa o tempo de processador da tarefa atual
-    // Não diferencia entre tarefas de usuário e sistema
-    current_task->processor_time++;
+    if (tick_fd >= 0)
+    {
+      // O dispatcher cobra sozinho os próprios ticks; uma tarefa que altera
+      // estruturas do núcleo recebe novo aviso no próximo tick
+      if (current_task->task_type != USER_TASK)
+        return;
+      if (preempt_count > 0)
+      {
+        tick_nudge(1);
+        return;
+      }
+      ticks = clock_tick_read(tick_fd);
+    }
+    else if (tick_timer != ITIMER_REAL)
+    {
+      // Os relógios de CPU do hospedeiro avançam na granularidade do tick
+      // dele, não do nosso: cobra o tempo de CPU decorrido desde o último sinal
+      unsigned long long cpu = clock_cpu_ns();
+
+      ticks = (cpu - tick_cpu) / TICK_NS;
+      tick_cpu += ticks * TICK_NS;
+    }
+
+    tick_count += ticks;
+    PROBE3(tick, current_task->id, tick_count, ready_total());
 
-    // Decrementa o quantum apenas para tarefas de usuário
-    if (current_task->task_type == USER_TASK)
+    // Apenas tarefas de usuário sofrem preempção, e não enquanto alteram
+    // estruturas do núcleo (a preempção fica para o próximo tick)
+    if (current_task->task_type == USER_TASK && preempt_count == 0)
     {
-      task_quantum--;
+      unsigned long long now = systime_ns();
+      // A tarefa também perde a CPU se uma classe de maior precedência tem
+      // tarefa pronta
+      int decision = charge_ticks(current_task, ticks);
 
-      // Se o quantum chegou a zero, preempta a tarefa
-      if (task_quantum == 0)
+      if (current_task->status == TASK_RUNNING)
       {
-        // Marca tarefa como pronta e devolve o controle ao dispatcher
-        if (current_task->status == TASK_RUNNING)
+        // Bloqueia a tarefa até wake_time (orçamento ou cota esgotados)
+        if (decision == SCHED_THROTTLE)
         {
+          TRACE(TRACE_PREEMPT, current_task->id, decision);
+          current_task->preempted = 1;
+          throttle_current();
+        }
+
+        // Marca tarefa como pronta e devolve o controle ao dispatcher,
+        // a menos que ela esteja em seção crítica curta; também devolve
+        // quando alguma tarefa adormecida deve acordar ou algum temporizador vence
+        else if (slice_extension(current_task, decision == SCHED_PREEMPT ||
+                                                   higher_class_ready(current_task) ||
+                                                   now >= next_wake ||
+                                                   ktimer_due(now / NS_PER_MS)))
+        {
+          TRACE(TRACE_PREEMPT, current_task->id, decision);
+          current_task->preempted = 1;
           task_yield();
         }
+
+        // A tarefa continua: novo aviso no próximo ponto de preempção
+        else if (tick_fd >= 0)
+          tick_nudge(nudge_ticks(current_task));
       }
     }
   }
@@ -93,132 +453,578 @@ int task_getprio(task_t *task)
   return task->static_prio;
 }
 
-// Escalonador - seleciona a tarefa de maior prioridade (menor valor) da fila
-task_t *scheduler()
+// Insere a tarefa na lista de todas as tarefas
+static void task_list_add(task_t *task)
+{
+  task->all_prev = NULL;
+  task->all_next = all_tasks;
+  if (all_tasks != NULL)
+    all_tasks->all_prev = task;
+  all_tasks = task;
+  all_count++;
+}
+
+// Retira da lista de todas as tarefas uma tarefa que terminou
+static void task_list_remove(task_t *task)
+{
+  if (task->all_prev != NULL)
+    task->all_prev->all_next = task->all_next;
+  else
+    all_tasks = task->all_next;
+  if (task->all_next != NULL)
+    task->all_next->all_prev = task->all_prev;
+  task->all_prev = task->all_next = NULL;
+  all_count--;
+}
+
+// Insere a tarefa no conjunto de prontas da sua classe
+static void ready_append(task_t *task)
 {
-  if (ready_queue == NULL)
-    return NULL;
+  int c = class_index(task);
+
+  ready_count[c]++;
+  sched_classes[c]->enqueue(task);
+}
 
-  // Localiza a tarefa com maior prioridade (menor valor numérico)
-  task_t *highest_prio_task = NULL;
-  task_t *current = (task_t *)ready_queue;
-  task_t *first = current;
-  int highest_prio = MAX_PRIO + 1; // Inicializa com um valor maior que qualquer prioridade possível
+// Retira a tarefa do conjunto de prontas da sua classe
+static void ready_remove(task_t *task)
+{
+  int c = class_index(task);
 
-  // Percorre a fila em busca da tarefa com maior prioridade (menor valor numérico)
-  do
+  ready_count[c]--;
+  sched_classes[c]->dequeue(task);
+}
+
+// Devolve ao conjunto de prontas uma tarefa que estava bloqueada
+static void ready_wake(task_t *task)
+{
+  task->status = TASK_READY;
+  task->ready_since = task->woken_at = systime_ns();
+  task->woken = 1;
+  sched_classes[class_index(task)]->on_wake(task);
+  ready_append(task);
+}
+
+// Muda a classe da tarefa; se ela está em uma fila de prontas, troca de fila
+static void change_class(task_t *task, int sched_class)
+{
+  preempt_disable();
+  if (task != current_task && task->status == TASK_READY)
   {
-    // Se a prioridade dinâmica desta tarefa for maior (valor menor)
-    if (current->dynamic_prio < highest_prio)
-    {
-      highest_prio = current->dynamic_prio;
-      highest_prio_task = current;
-    }
-    current = current->next;
-  } while (current != first);
+    ready_remove(task);
+    task->sched_class = sched_class;
+    ready_append(task);
+  }
+  else
+    task->sched_class = sched_class;
+  preempt_enable();
+}
+
+// Define a classe de escalonamento de uma tarefa (ou da atual, se task==NULL)
+int task_setclass(task_t *task, int sched_class)
+{
+  // A classe EDF exige parâmetros: use task_setdeadline()
+  if (sched_class != SCHED_CLASS_NORMAL && sched_class != SCHED_CLASS_FIFO &&
+      sched_class != SCHED_CLASS_RR)
+    return -1;
+
+  // Se a tarefa não foi especificada, use a tarefa atual
+  if (task == NULL)
+    task = current_task;
+
+  // Tarefas de sistema (dispatcher) não mudam de classe
+  if (task->task_type == SYSTEM_TASK)
+    return -1;
+
+  // Ao deixar a classe EDF, a tarefa libera a utilização reservada
+  if (task->sched_class == SCHED_CLASS_DEADLINE)
+    sched_dl_release(task);
+
+  change_class(task, sched_class);
 
-  // Envelhece todas as tarefas que não foram escolhidas
-  current = first;
-  do
+  // Tarefas de tempo real não envelhecem: descarta o envelhecimento acumulado
+  task->dynamic_prio = task->static_prio;
+
+  return 0;
+}
+
+// A tarefa atual entra em uma seção crítica curta
+void task_cs_begin()
+{
+  current_task->cs_flag = 1;
+}
+
+// A tarefa atual sai da seção crítica; libera a CPU se a preempção foi adiada
+void task_cs_end()
+{
+  current_task->cs_flag = 0;
+
+  if (current_task->cs_pending)
   {
-    if (current != highest_prio_task)
-    {
-      // Aplica o envelhecimento (aumenta a prioridade - diminui o valor)
-      current->dynamic_prio += ALPHA;
+    current_task->cs_pending = 0;
+    task_yield();
+  }
+}
 
-      // Garante que não ultrapasse a prioridade máxima
-      if (current->dynamic_prio < MIN_PRIO)
-        current->dynamic_prio = MIN_PRIO;
-    }
-    current = current->next;
-  } while (current != first);
+// Coloca uma tarefa (ou a atual, se task==NULL) em um grupo de controle de banda
+int task_setgroup(task_t *task, task_group_t *group)
+{
+  // Se a tarefa não foi especificada, use a tarefa atual
+  if (task == NULL)
+    task = current_task;
+
+  // Tarefas de sistema (dispatcher) não são limitadas
+  if (task->task_type == SYSTEM_TASK)
+    return -1;
+
+  // Vale a partir do próximo tick cobrado ou da próxima ativação
+  task->group = group;
+
+  return 0;
+}
+
+// Define os bilhetes de uma tarefa (ou da atual, se task==NULL)
+int task_settickets(task_t *task, int tickets)
+{
+  if (tickets <= 0 || tickets > MAX_TICKETS)
+    return -1;
+
+  // Se a tarefa não foi especificada, use a tarefa atual
+  if (task == NULL)
+    task = current_task;
+
+  // Vale a partir do próximo tick cobrado: o passo acumulado não muda,
+  // então a tarefa não precisa ser reposicionada no heap
+  task->tickets = tickets;
+
+  return 0;
+}
+
+// Retorna os bilhetes de uma tarefa (ou da atual, se task==NULL)
+int task_gettickets(task_t *task)
+{
+  // Se a tarefa não foi especificada, use a tarefa atual
+  if (task == NULL)
+    task = current_task;
+
+  return task->tickets;
+}
+
+// Coloca uma tarefa (ou a atual, se task==NULL) na classe EDF
+int task_setdeadline(task_t *task, int period_ms, int runtime_ms, int deadline_ms)
+{
+  // Se o prazo não foi informado, vale o período
+  if (deadline_ms == 0)
+    deadline_ms = period_ms;
+
+  // O orçamento deve caber no prazo, e o prazo no período
+  if (runtime_ms <= 0 || runtime_ms > deadline_ms || deadline_ms > period_ms)
+    return -1;
 
-  // Reseta a prioridade dinâmica da tarefa escolhida para seu valor estático
-  highest_prio_task->dynamic_prio = highest_prio_task->static_prio;
+  // Se a tarefa não foi especificada, use a tarefa atual
+  if (task == NULL)
+    task = current_task;
+
+  // Tarefas de sistema (dispatcher) não mudam de classe
+  if (task->task_type == SYSTEM_TASK)
+    return -1;
+
+  // Com os relógios de CPU um sinal pode cobrar vários ticks de uma vez: o
+  // orçamento seria ultrapassado e os prazos perdidos
+  if (tick_timer != ITIMER_REAL)
+    return -1;
+
+  // Teste de admissão: rejeita se a utilização total passar do limite
+  if (sched_dl_admit(task, period_ms, runtime_ms, deadline_ms) < 0)
+    return -1;
+
+  change_class(task, SCHED_CLASS_DEADLINE);
 
-  return highest_prio_task;
+  return 0;
+}
+
+// Retorna a classe de escalonamento de uma tarefa (ou da atual, se task==NULL)
+int task_getclass(task_t *task)
+{
+  // Se a tarefa não foi especificada, use a tarefa atual
+  if (task == NULL)
+    task = current_task;
+
+  return task->sched_class;
+}
+
+// Define o quantum de uma tarefa RR (ou da atual, se task==NULL)
+int task_setquantum(task_t *task, int quantum)
+{
+  if (quantum <= 0)
+    return -1;
+
+  // Se a tarefa não foi especificada, use a tarefa atual
+  if (task == NULL)
+    task = current_task;
+
+  // O novo valor vale a partir da próxima ativação da tarefa
+  task->quantum = quantum;
+
+  return 0;
+}
+
+// Retorna o quantum de uma tarefa (ou da atual, se task==NULL)
+int task_getquantum(task_t *task)
+{
+  // Se a tarefa não foi especificada, use a tarefa atual
+  if (task == NULL)
+    task = current_task;
+
+  return task->quantum;
+}
+
+// Escalonador - consulta as classes em ordem de precedência e retorna a
+// tarefa escolhida pela política da primeira classe com tarefas prontas
+task_t *scheduler()
+{
+  for (int i = 0; i < NUM_CLASSES; i++)
+    if (ready_count[i] > 0)
+      return sched_classes[i]->pick_next();
+
+  return NULL;
 }
 
 // Função para verificar e acordar tarefas adormecidas
 void check_sleeping_tasks()
 {
-  if (sleeping_queue == NULL)
+  unsigned long long current_time = systime_ns();
+  rb_node_t *first;
+  task_t *task;
+
+  // As tarefas vencidas estão no início da árvore: todas são acordadas
+  // nesta passagem do dispatcher
+  while ((first = rb_first(&sleep_tree)) != NULL)
+  {
+    task = rb_entry(first, task_t, rb_node);
+    if (task->wake_time > current_time)
+      break;
+
+    rb_remove(&sleep_tree, first);
+    sleeping_count--;
+    ready_wake(task);
+    task->woken_at = task->wake_time; // A latência conta do instante pedido
+    TRACE(TRACE_WAKEUP, task->id, current_time - task->wake_time);
+    PROBE3(task__wake, task->id, current_time - task->wake_time, sleeping_count);
+  }
+
+  // Registra o próximo despertar, para que o tratador de ticks devolva a CPU
+  // ao dispatcher assim que ele chegar
+  next_wake = first ? rb_entry(first, task_t, rb_node)->wake_time : NO_WAKE;
+}
+
+// Encerra pelo prazo a espera de uma tarefa (executada pelo dispatcher)
+static void timeout_expired(ktimer_t *timer, void *arg)
+{
+  task_t *task = arg;
+
+  // A tarefa pode ter sido acordada antes de o temporizador ser cancelado
+  if (task->status != TASK_SUSPENDED)
     return;
 
-  unsigned int current_time = systime();
+  task->timed_out = 1;
+  task_awake(task, task->timeout_queue);
+  if (task->timeout_undo != NULL)
+    task->timeout_undo(task->timeout_object);
+}
 
-  // Ponteiro para percorrer a fila, inicializado apontando para o início da fila
-  task_t *current = sleeping_queue;
+// Ajusta o quantum para que todas as tarefas prontas executem dentro da
+// latência alvo, sem descer abaixo da granularidade mínima nem de um valor
+// em que o custo das trocas (medido desde "start") passe de 1/OVERHEAD_RATIO
+static void quantum_update(unsigned long long start)
+{
+  unsigned long long sample = clock_ns() - start;
+  int ready = ready_total(); // Inclui a tarefa que vai executar, ainda pronta
+  int quantum, floor;
 
-  // Guarda a referência do primeiro elemento da fila
-  task_t *first = current;
+  // Média móvel exponencial do custo de uma decisão do dispatcher
+  switch_overhead_ns = (7 * switch_overhead_ns + sample) / 8;
 
-  // Ponteiro auxiliar que será usado para marcar tarefas que devem ser acordadas
-  task_t *to_awake = NULL;
+  quantum = target_latency * 1000 / TICK_INTERVAL / ready;
+  if (quantum < min_granularity)
+    quantum = min_granularity;
+  floor = (switch_overhead_ns * OVERHEAD_RATIO + TICK_NS - 1) / TICK_NS;
+  if (quantum < floor)
+    quantum = floor;
 
-  do
+  if (quantum != sched_quantum)
   {
-    // Verifica se a tarefa deve acordar
-    if (current_time >= current->wake_time)
-    {
-      to_awake = current;
-      current = current->next;
+    sched_quantum = quantum;
+    quantum_updates++;
+  }
+}
 
-      // Remove da fila de sleeping
-      queue_remove((queue_t **)&sleeping_queue, (queue_t *)to_awake);
+// Preenche o estado do ajuste automático do quantum
+int ppos_quantum_stats(quantum_stats_t *stats)
+{
+  if (stats == NULL)
+    return -1;
 
-      // Coloca na fila de prontos
-      to_awake->status = TASK_READY;
-      queue_append((queue_t **)&ready_queue, (queue_t *)to_awake);
+  stats->enabled = (target_latency > 0);
+  stats->quantum = sched_quantum;
+  stats->target_latency = target_latency;
+  stats->min_granularity = min_granularity;
+  stats->switch_overhead_ns = switch_overhead_ns;
+  stats->updates = quantum_updates;
 
-      // Se a fila ficou vazia, sai do loop
-      if (sleeping_queue == NULL)
-        break;
+  return 0;
+}
 
-      // Reinicia a verificação desde o início da fila
-      current = sleeping_queue;
-      first = current;
-    }
-    else
-    {
-      current = current->next;
-    }
-  } while (current != first && sleeping_queue != NULL);
+// Preenche a divisão do tempo desde a inicialização
+int ppos_cpu_stats(cpu_stats_t *stats)
+{
+  unsigned long long now;
+
+  if (stats == NULL)
+    return -1;
+
+  // O trecho em curso, ainda não medido, é da tarefa atual
+  preempt_disable();
+  now = clock_ns();
+  stats->user_ns = user_ns;
+  stats->kernel_ns = kernel_ns;
+  stats->idle_ns = idle_ns;
+  if (current_task->task_type == USER_TASK)
+    stats->user_ns += now - switch_time;
+  else
+    stats->kernel_ns += now - switch_time;
+  preempt_enable();
+
+  return 0;
+}
+
+// Preenche as estatísticas do sistema e de até max_tasks tarefas, com a taxa
+// de trocas medida desde a referência "rate" (que é atualizada); retorna o
+// número de tarefas preenchidas
+int stats_fill(ppos_stats_t *stats, task_stats_t *tasks, int max_tasks, stats_rate_t *rate)
+{
+  unsigned long long now, elapsed;
+  task_t *task;
+  int i, n = 0;
+
+  if (stats == NULL || (tasks == NULL && max_tasks > 0))
+    return -1;
+
+  // Cópia consistente: nem o tick nem o dispatcher alteram as estruturas
+  // enquanto ela é feita
+  preempt_disable();
+  now = systime_ns();
+
+  stats->uptime_ns = now;
+  stats->tasks = all_count;
+  stats->user_tasks = user_tasks_count;
+  stats->ready = 0;
+  for (i = 0; i < NUM_CLASSES; i++)
+    stats->ready += ready_count[i];
+  stats->sleeping = sleeping_count;
+  stats->switches = switch_count;
+  stats->ticks = tick_count;
+  stats->user_ns = user_ns;
+  stats->kernel_ns = kernel_ns;
+  stats->idle_ns = idle_ns;
+  stats->quantum = sched_quantum;
+
+  // Taxa de trocas desde a referência anterior (ou desde a inicialização)
+  elapsed = now - rate->time;
+  stats->switch_rate = elapsed ? (switch_count - rate->switches) * 1000000000ULL / elapsed : 0;
+  rate->time = now;
+  rate->switches = switch_count;
+
+  for (task = all_tasks; task != NULL && n < max_tasks; task = task->all_next, n++)
+  {
+    tasks[n].id = task->id;
+    tasks[n].status = task->status;
+    tasks[n].task_type = task->task_type;
+    tasks[n].sched_class = task->sched_class;
+    tasks[n].static_prio = task->static_prio;
+    tasks[n].dynamic_prio = task->dynamic_prio;
+    tasks[n].run_ns = task->run_ns;
+    tasks[n].cpu_ns = task->cpu_ns;
+    tasks[n].activations = task->activations;
+    tasks[n].voluntary = task->voluntary;
+    tasks[n].involuntary = task->involuntary;
+    tasks[n].sleeps = task->sleeps;
+    tasks[n].throttles = task->throttles;
+    tasks[n].wait_ns = task->wait_hist.sum;
+
+    // O trecho em curso da tarefa atual ainda não foi medido
+    if (task == current_task)
+      tasks[n].run_ns += clock_ns() - switch_time;
+  }
+  preempt_enable();
+
+  return n;
+}
+
+// Preenche as estatísticas do sistema e de até max_tasks tarefas
+int ppos_stats_snapshot(ppos_stats_t *stats, task_stats_t *tasks, int max_tasks)
+{
+  return stats_fill(stats, tasks, max_tasks, &snapshot_rate);
+}
+
+// Modo timerfd: cobra da tarefa que acabou de deixar a CPU os ticks ainda
+// não cobrados; se ela saiu pronta mas esgotou orçamento ou cota, adormece
+static void tick_settle(task_t *task)
+{
+  unsigned long long ticks = clock_tick_read(tick_fd);
+
+  if (ticks == 0)
+    return;
+
+  tick_count += ticks;
+  if (task->status != TASK_TERMINATED &&
+      charge_ticks(task, ticks) == SCHED_THROTTLE && task->status == TASK_READY)
+    throttle_insert(task);
+}
+
+// Registra as latências de uma tarefa escolhida pelo dispatcher
+static void latency_record(task_t *task, unsigned long long decision)
+{
+  unsigned long long now = systime_ns();
+
+  hist_add(&decision_hist, decision);
+  hist_add(&task->wait_hist, now - task->ready_since);
+  hist_add(&wait_hist, now - task->ready_since);
+  if (task->woken)
+  {
+    // Tarefas acordadas com atraso pelo dispatcher podem ter woken_at futuro
+    unsigned long long latency = (now > task->woken_at) ? now - task->woken_at : 0;
+
+    hist_add(&task->wakeup_hist, latency);
+    hist_add(&wakeup_hist, latency);
+    task->woken = 0;
+  }
+}
+
+// Preenche os percentis de um tipo de latência do sistema (task==NULL) ou
+// de uma tarefa
+int ppos_latency_stats(task_t *task, int kind, latency_stats_t *stats)
+{
+  const hist_t *hist;
+
+  if (stats == NULL)
+    return -1;
+
+  switch (kind)
+  {
+  case LATENCY_WAIT:
+    hist = task ? &task->wait_hist : &wait_hist;
+    break;
+  case LATENCY_WAKEUP:
+    hist = task ? &task->wakeup_hist : &wakeup_hist;
+    break;
+  case LATENCY_DECISION:
+    if (task != NULL)
+      return -1;
+    hist = &decision_hist;
+    break;
+  default:
+    return -1;
+  }
+
+  preempt_disable();
+  stats->count = hist->count;
+  stats->avg = hist->count ? hist->sum / hist->count : 0;
+  stats->p50 = hist_percentile(hist, 50);
+  stats->p99 = hist_percentile(hist, 99);
+  stats->p999 = hist_percentile(hist, 99.9);
+  stats->max = hist->max;
+  preempt_enable();
+
+  return 0;
 }
 
 // Corpo do dispatcher
 void dispatcher_body(void *arg)
 {
   task_t *next;
+  task_group_t *group;
+  unsigned long long start = 0, decision;
 
   // Salva o momento de início do dispatcher
   dispatcher_task.start_time = systime();
 
+  // A main executava antes do dispatcher: se foi preemptada, volta ao
+  // conjunto de prontas como qualquer tarefa que ele tivesse despachado
+  if (main_task.status == TASK_READY)
+  {
+    sched_classes[class_index(&main_task)]->on_yield(&main_task);
+    main_task.ready_since = systime_ns();
+    ready_append(&main_task);
+  }
+
   // Enquanto houverem tarefas de usuário ou tarefas adormecidas
-  while (user_tasks_count > 0 || sleeping_queue != NULL)
+  while (user_tasks_count > 0 || sleeping_count > 0)
   {
+    // Mede o custo da decisão para o ajuste automático do quantum
+    if (target_latency > 0)
+      start = clock_ns();
+
+    // Modo timerfd: os ticks desde o último ponto seguro foram do dispatcher,
+    // que não é cobrado por política
+    if (tick_fd >= 0)
+      tick_count += clock_tick_read(tick_fd);
+
     // Verifica se há tarefas adormecidas que devem acordar
     check_sleeping_tasks();
 
+    // Executa os temporizadores vencidos
+    ktimer_run(systime_ns() / NS_PER_MS);
+
+    // Atualiza as estatísticas publicadas em memória compartilhada
+    stats_shm_update(systime_ns());
+
     // Escolhe a próxima tarefa a executar
+    decision = clock_ns();
     next = scheduler();
 
+    // Se o grupo da escolhida esgotou a cota, ela aguarda adormecida o
+    // próximo período do grupo, e a escolha é refeita na mesma decisão
+    while (next != NULL && (group = group_throttled(next, systime_ns())) != NULL)
+    {
+      ready_remove(next);
+      next->wake_time = group->period_start + group->period * NS_PER_MS;
+      throttle_insert(next);
+      sched_repick = 1;
+      next = scheduler();
+      sched_repick = 0;
+    }
+    decision = clock_ns() - decision;
+
     if (next != NULL)
     {
-      // Remove da fila de prontas
-      queue_remove(&ready_queue, (queue_t *)next);
+      // Ajusta o quantum antes que a política renove a fatia da tarefa
+      if (target_latency > 0)
+        quantum_update(start);
+
+      // Remove da fila de prontas (a política renova a fatia de tempo)
+      ready_remove(next);
+      next->cs_pending = 0;
 
-      // Reseta o quantum para a próxima tarefa
-      task_quantum = QUANTUM;
+      // Registra as latências da escolha e da espera da tarefa
+      latency_record(next, decision);
 
-      // Transfere controle para a próxima tarefa
+      // Transfere controle para a próxima tarefa (no modo timerfd, com o
+      // aviso de preempção armado para o fim da fatia)
+      if (tick_fd >= 0)
+        tick_nudge(nudge_ticks(next));
       task_switch(next);
 
+      // Modo timerfd: cobra da tarefa os ticks que ela usou desde o último aviso
+      if (tick_fd >= 0)
+        tick_settle(next);
+
       // Voltando ao dispatcher, trata a tarefa de acordo com seu estado
       if (next->status == TASK_TERMINATED)
       {
         // Decrementa o contador de tarefas de usuário
         user_tasks_count--;
+        task_list_remove(next);
 
         // Libera a pilha alocada para a tarefa
         if (next->stack)
@@ -230,55 +1036,190 @@ void dispatcher_body(void *arg)
       else if (next->status == TASK_READY)
       {
         // Reinsere na fila de prontas se não terminou
-        queue_append(&ready_queue, (queue_t *)next);
+        sched_classes[class_index(next)]->on_yield(next);
+        next->ready_since = systime_ns();
+        ready_append(next);
       }
       // Se status == TASK_SUSPENDED, não faz nada (fica suspensa)
     }
+    else
+    {
+      // Nenhuma tarefa pronta: libera o processador hospedeiro até o próximo
+      // despertar (ou até o próximo tick, que pode vencer temporizadores);
+      // no modo timerfd, até a próxima expiração do timerfd
+      account(&dispatcher_task);
+      if (tick_fd >= 0)
+      {
+        tick_nudge(0);
+        tick_count += clock_tick_wait(tick_fd);
+      }
+      else if (tick_timer != ITIMER_REAL)
+      {
+        // Relógios de CPU não geram ticks com o processo parado: dorme no
+        // máximo um tick, para ainda vencer os temporizadores
+        unsigned long long until = clock_ns() + TICK_NS;
+
+        if (next_wake != NO_WAKE && boot_time + next_wake < until)
+          until = boot_time + next_wake;
+        clock_sleep_until(until);
+      }
+      else
+        clock_sleep_until(next_wake == NO_WAKE ? NO_WAKE : boot_time + next_wake);
+      account_idle();
+    }
   }
 
   // Calcula o tempo de execução do dispatcher
   dispatcher_task.execution_time = systime() - dispatcher_task.start_time;
 
   // Imprime as estatísticas do dispatcher antes de encerrar
-  printf("Task %d exit: execution time %6d ms, processor time %6d ms, %d activations\n",
+  account(&dispatcher_task);
+  printf("Task %d exit: execution time %6d ms, processor time %6d ms (host %6llu ms), idle time %6llu ms, %d activations, "
+         "wait p50/p99/p999 %llu/%llu/%llu us, wakeup p50/p99/p999 %llu/%llu/%llu us, "
+         "decision p50/p99/p999 %llu/%llu/%llu ns\n",
          dispatcher_task.id, dispatcher_task.execution_time, dispatcher_task.processor_time,
-         dispatcher_task.activations);
+         dispatcher_task.cpu_ns / NS_PER_MS, idle_ns / NS_PER_MS, dispatcher_task.activations,
+         hist_percentile(&wait_hist, 50) / 1000, hist_percentile(&wait_hist, 99) / 1000,
+         hist_percentile(&wait_hist, 99.9) / 1000, hist_percentile(&wakeup_hist, 50) / 1000,
+         hist_percentile(&wakeup_hist, 99) / 1000, hist_percentile(&wakeup_hist, 99.9) / 1000,
+         hist_percentile(&decision_hist, 50), hist_percentile(&decision_hist, 99),
+         hist_percentile(&decision_hist, 99.9));
 
   // Encerra a tarefa dispatcher retornando à main
   task_switch(&main_task);
 }
 
+// Tratador do sinal dos ticks: com o perfil ligado, amostra o ponto em que a
+// tarefa atual foi interrompida antes de tratar o tick
+static void tick_handler(int signum, siginfo_t *info, void *context)
+{
+  if (prof_enabled && current_task != NULL)
+    prof_sample(context, current_task->id, current_task->stack,
+                current_task->stack ? STACKSIZE : 0);
+
+  timer_handler(signum);
+}
+
+// Desliga a preempção ao fim do processo: as rotinas de saída que salvam o
+// registro de eventos e o perfil não podem perder a CPU para outra tarefa
+static void timer_atexit()
+{
+  preempt_disable();
+  tick_nudge(0);
+}
+
 // Inicializa o sistema de tempo
 void timer_init()
 {
-  // Registra o tratador de sinal para SIGALRM
-  action.sa_handler = timer_handler;
+  // Registra o tratador de sinal do relógio dos ticks
+  action.sa_sigaction = tick_handler;
   sigemptyset(&action.sa_mask);
-  action.sa_flags = 0;
-  if (sigaction(SIGALRM, &action, 0) < 0)
+  action.sa_flags = SA_SIGINFO;
+  if (sigaction(tick_signal, &action, 0) < 0)
   {
     perror("Erro em sigaction: ");
     exit(1);
   }
 
-  // Configura o temporizador para disparar a cada 1ms
+  // Registrada após as rotinas de saída dos demais módulos, executa antes delas
+  atexit(timer_atexit);
+
+  // Modo timerfd: o timerfd conta os ticks e o sinal só é armado, pelo
+  // dispatcher, para o fim da fatia de cada tarefa
+  if (tick_fd >= 0)
+    return;
+
+  // Configura o temporizador para disparar a cada 1ms (de tempo real, de
+  // CPU em modo usuário ou de CPU total do processo, conforme o relógio)
   timer.it_value.tv_usec = TICK_INTERVAL;    // primeiro disparo, em microssegundos
   timer.it_value.tv_sec = 0;                 // primeiro disparo, em segundos
   timer.it_interval.tv_usec = TICK_INTERVAL; // disparos subsequentes, em microssegundos
   timer.it_interval.tv_sec = 0;              // disparos subsequentes, em segundos
 
   // Ativa o temporizador
-  if (setitimer(ITIMER_REAL, &timer, 0) < 0)
+  if (setitimer(tick_timer, &timer, 0) < 0)
   {
     perror("Erro em setitimer: ");
     exit(1);
   }
 }
 
+// Retorna o relógio atual (em nanossegundos), derivado do relógio monotônico
+// do hospedeiro: não perde ticks quando sinais de temporizador se acumulam
+unsigned long long systime_ns()
+{
+  return clock_ns() - boot_time;
+}
+
+// Retorna o relógio atual (em microssegundos)
+unsigned long long systime_us()
+{
+  return systime_ns() / 1000;
+}
+
 // Retorna o relógio atual (em milisegundos)
 unsigned int systime()
 {
-  return system_clock;
+  return systime_ns() / NS_PER_MS;
+}
+
+// Suspende a tarefa atual até o instante indicado (em ns)
+static void sleep_until(unsigned long long wake_time)
+{
+  unsigned long long slack = current_task->timer_slack;
+
+  // Com folga, o despertar vai para o próximo múltiplo dela, onde coincide
+  // com o de outras tarefas e é tratado na mesma passagem do dispatcher
+  if (slack > 0)
+    wake_time = (wake_time + slack - 1) / slack * slack;
+
+  current_task->wake_time = wake_time;
+  sleep_current();
+}
+
+// Faz com que a tarefa atual fique suspensa até o instante indicado (em ns)
+void task_sleep_until(unsigned long long abs_time)
+{
+  // Se o instante já passou, não faz nada
+  if (abs_time <= systime_ns())
+    return;
+
+  block_mark(OFFCPU_SLEEP, NULL, __builtin_return_address(0));
+  sleep_until(abs_time);
+}
+
+// Define a folga dos despertares de uma tarefa (em microssegundos)
+int task_setslack(task_t *task, long slack_us)
+{
+  if (slack_us < 0)
+    return -1;
+
+  if (task == NULL)
+    task = current_task;
+
+  task->timer_slack = slack_us * 1000ULL;
+
+  return 0;
+}
+
+// Retorna a folga dos despertares de uma tarefa (em microssegundos)
+long task_getslack(task_t *task)
+{
+  if (task == NULL)
+    task = current_task;
+
+  return task->timer_slack / 1000;
+}
+
+// Faz com que a tarefa atual fique suspensa durante o intervalo indicado em microssegundos
+void task_sleep_us(long t)
+{
+  // Se o tempo é zero ou negativo, não faz nada
+  if (t <= 0)
+    return;
+
+  block_mark(OFFCPU_SLEEP, NULL, __builtin_return_address(0));
+  sleep_until(systime_ns() + t * 1000ULL);
 }
 
 // Faz com que a tarefa atual fique suspensa durante o intervalo indicado em milissegundos
@@ -288,29 +1229,217 @@ void task_sleep(int time_sleep)
   if (time_sleep <= 0)
     return;
 
-  // Calcula o momento em que a tarefa deve acordar
-  current_task->wake_time = systime() + time_sleep;
+  // Acorda na fronteira de milissegundo, para que a diferença entre duas
+  // leituras de systime() corresponda exatamente ao intervalo pedido
+  block_mark(OFFCPU_SLEEP, NULL, __builtin_return_address(0));
+  sleep_until((systime() + (unsigned long long)time_sleep) * NS_PER_MS);
+}
+
+// Torna a tarefa periódica; o período atual começa agora
+int task_set_period(task_t *task, long period_us)
+{
+  if (period_us < 0)
+    return -1;
+
+  if (task == NULL)
+    task = current_task;
+
+  task->period_ns = period_us * 1000ULL;
+  task->next_release = systime_ns();
+
+  return 0;
+}
+
+// Aguarda a próxima liberação periódica da tarefa atual
+int task_wait_period()
+{
+  task_t *task = current_task;
+  unsigned long long now = systime_ns();
+  unsigned long long jitter;
+  int missed = 0;
+
+  if (task->period_ns == 0)
+    return -1;
+
+  // A próxima liberação é contada a partir da anterior, sem acumular o tempo
+  // de trabalho nem o atraso de ativação
+  task->next_release += task->period_ns;
+
+  // O trabalho ultrapassou o período: descarta as liberações perdidas
+  if (task->next_release < now)
+  {
+    missed = (now - task->next_release) / task->period_ns + 1;
+    task->next_release += missed * task->period_ns;
+    task->overruns += missed;
+  }
+
+  block_mark(OFFCPU_PERIOD, NULL, __builtin_return_address(0));
+  sleep_until(task->next_release);
+
+  // Atraso entre a liberação e o retorno à execução
+  jitter = systime_ns() - task->next_release;
+  task->releases++;
+  task->jitter_sum += jitter;
+  if (jitter > task->jitter_max)
+    task->jitter_max = jitter;
 
-  // Suspende a tarefa atual na fila de tarefas adormecidas
-  task_suspend(&sleeping_queue);
+  return missed;
 }
 
-// Inicializa o sistema
-void ppos_init()
+// Preenche as estatísticas periódicas da tarefa
+int task_period_stats(task_t *task, period_stats_t *stats)
 {
+  if (stats == NULL)
+    return -1;
+
+  if (task == NULL)
+    task = current_task;
+
+  stats->period_us = task->period_ns / 1000;
+  stats->releases = task->releases;
+  stats->overruns = task->overruns;
+  stats->jitter_avg_ns = task->releases ? task->jitter_sum / task->releases : 0;
+  stats->jitter_max_ns = task->jitter_max;
+
+  return 0;
+}
+
+// Inicializa o sistema com a configuração indicada (NULL: padrão)
+void ppos_init_config(const ppos_config_t *config)
+{
+  const char *policy_name = NULL;
+  const char *tick_source = NULL;
+  const char *tick_clock = NULL;
+  const char *profile_file = NULL;
+  int quantum = 0, profile_period = 0;
+  char *env;
+
   setvbuf(stdout, 0, _IONBF, 0);
 
+  // Campos da configuração têm precedência sobre as variáveis de ambiente
+  if (config != NULL)
+  {
+    policy_name = config->sched_policy;
+    quantum = config->quantum;
+    if (config->aging != 0)
+      sched_aging = config->aging;
+  }
+  if (policy_name == NULL)
+    policy_name = getenv("PPOS_SCHED");
+  if (quantum <= 0 && (env = getenv("PPOS_QUANTUM")) != NULL)
+    quantum = atoi(env);
+
+  // Ajuste automático do quantum
+  if (config != NULL && config->target_latency > 0)
+    target_latency = config->target_latency;
+  else if ((env = getenv("PPOS_LATENCY")) != NULL)
+    target_latency = atoi(env);
+  if (config != NULL && config->min_granularity > 0)
+    min_granularity = config->min_granularity;
+
+  // Origem dos ticks
+  if (config != NULL)
+    tick_source = config->tick_source;
+  if (tick_source == NULL)
+    tick_source = getenv("PPOS_TICK");
+  if (tick_source != NULL && strcmp(tick_source, "timerfd") == 0)
+  {
+    tick_fd = clock_tick_open(TICK_NS);
+    if (tick_fd < 0)
+    {
+      perror("ppos_init: timerfd");
+      exit(1);
+    }
+  }
+  else if (tick_source != NULL && strcmp(tick_source, "signal") != 0)
+  {
+    fprintf(stderr, "ppos_init: origem de ticks desconhecida: %s\n", tick_source);
+    exit(1);
+  }
+
+  // Relógio dos ticks: tempo real, ou tempo de CPU efetivamente consumido
+  // (só em modo usuário, ou total), que não avança com o processo parado
+  if (config != NULL)
+    tick_clock = config->tick_clock;
+  if (tick_clock == NULL)
+    tick_clock = getenv("PPOS_TICK_CLOCK");
+  if (tick_clock != NULL && strcmp(tick_clock, "virtual") == 0)
+  {
+    tick_timer = ITIMER_VIRTUAL;
+    tick_signal = SIGVTALRM;
+  }
+  else if (tick_clock != NULL && strcmp(tick_clock, "prof") == 0)
+  {
+    tick_timer = ITIMER_PROF;
+    tick_signal = SIGPROF;
+  }
+  else if (tick_clock != NULL && strcmp(tick_clock, "real") != 0)
+  {
+    fprintf(stderr, "ppos_init: relogio de ticks desconhecido: %s\n", tick_clock);
+    exit(1);
+  }
+
+  // O timerfd conta tempo real
+  if (tick_fd >= 0 && tick_timer != ITIMER_REAL)
+  {
+    fprintf(stderr, "ppos_init: a origem timerfd exige o relogio real\n");
+    exit(1);
+  }
+
+  // Escolhe a política da classe normal
+  if (policy_name != NULL)
+  {
+    sched_normal = sched_policy_find(policy_name);
+    if (sched_normal == NULL)
+    {
+      fprintf(stderr, "ppos_init: politica de escalonamento desconhecida: %s\n", policy_name);
+      exit(1);
+    }
+  }
+  sched_classes[CLASS_NORMAL] = sched_normal;
+  sched_quantum = (quantum > 0) ? quantum : QUANTUM;
+
+  // Parâmetros da política "mlfq"
+  if (config != NULL && config->mlfq_levels > 0)
+    mlfq_levels = (config->mlfq_levels < MLFQ_MAX_LEVELS) ? config->mlfq_levels : MLFQ_MAX_LEVELS;
+  if (config != NULL && config->mlfq_boost > 0)
+    mlfq_boost = config->mlfq_boost;
+
   // Inicializa a tarefa main
   main_task.id = 0;
-  main_task.status = TASK_READY;
+  main_task.status = TASK_RUNNING;
   main_task.prev = main_task.next = NULL;
   main_task.stack = NULL;
   main_task.exit_code = 0;
   main_task.static_prio = DEFAULT_PRIO;
   main_task.dynamic_prio = DEFAULT_PRIO;
   main_task.task_type = USER_TASK; // Main é uma tarefa de usuário
+  main_task.sched_class = SCHED_CLASS_NORMAL;
+  main_task.quantum = sched_quantum;
+  main_task.slice = sched_quantum;
+  main_task.vruntime = 0;
+  main_task.deadline_misses = 0;
+  main_task.dl_throttles = 0;
+  main_task.mlfq_level = 0;
+  main_task.mlfq_epoch = 0;
+  main_task.tickets = DEFAULT_TICKETS;
+  main_task.pass = 0;
+  main_task.heap_index = -1;
+  main_task.group = NULL;
+  main_task.period_ns = 0;
+  main_task.timed_out = 0;
+  ktimer_init(&main_task.timeout, timeout_expired, &main_task);
+  main_task.releases = 0;
+  main_task.overruns = 0;
+  main_task.jitter_sum = 0;
+  main_task.jitter_max = 0;
+  main_task.cs_flag = 0;
+  main_task.cs_pending = 0;
+  main_task.cs_extensions = 0;
+  main_task.cs_abuses = 0;
   main_task.waiting_queue = NULL;  // Inicializa a fila de espera
   main_task.wake_time = 0;         // Inicializa o campo wake_time
+  main_task.timer_slack = 0;
 
   // Inicializa os contadores de tempo
   main_task.execution_time = 0;
@@ -318,6 +1447,18 @@ void ppos_init()
   main_task.activations = 0;
   main_task.start_time = 0;
   main_task.last_activation = 0;
+  main_task.run_ns = 0;
+  main_task.cpu_ns = 0;
+  memset(main_task.perf, 0, sizeof(main_task.perf));
+  main_task.voluntary = 0;
+  main_task.involuntary = 0;
+  main_task.sleeps = 0;
+  main_task.throttles = 0;
+  main_task.preempted = 0;
+  main_task.block_site = NULL;
+  main_task.woken = 0;
+  hist_init(&main_task.wait_hist);
+  hist_init(&main_task.wakeup_hist);
 
   if (getcontext(&main_task.context) == -1)
   {
@@ -327,15 +1468,21 @@ void ppos_init()
 
   // Define a tarefa atual como a main
   current_task = &main_task;
+  task_list_add(&main_task);
 
-  // Inicializa o contador de tarefas de usuário
-  user_tasks_count = 0;
+  // Inicializa o contador de tarefas de usuário; a main conta, pois pode ser
+  // preemptada e precisa que o dispatcher continue escalonando até o fim dela
+  user_tasks_count = 1;
 
   // Inicializa o relógio do sistema
-  system_clock = 0;
+  boot_time = clock_ns();
+  switch_time = boot_time;
+  switch_cpu = tick_cpu = clock_cpu_ns();
 
-  // Define o quantum inicial
-  task_quantum = QUANTUM;
+  // Contadores de desempenho, lidos a cada troca de contexto
+  if ((config != NULL && config->perf_counters) ||
+      ((env = getenv("PPOS_PERF")) != NULL && atoi(env) != 0))
+    perf_init();
 
   // Cria a tarefa dispatcher como tarefa de sistema
   task_init(&dispatcher_task, dispatcher_body, NULL);
@@ -344,9 +1491,37 @@ void ppos_init()
   dispatcher_task.task_type = SYSTEM_TASK;
 
   // A tarefa dispatcher não deve ser contada como tarefa de usuário
-  queue_remove(&ready_queue, (queue_t *)&dispatcher_task);
+  ready_remove(&dispatcher_task);
   user_tasks_count--;
 
+  // Estatísticas publicadas em memória compartilhada
+  stats_shm_init((config != NULL && config->stats_file != NULL) ? config->stats_file
+                                                                : getenv("PPOS_STATS_FILE"));
+
+  // Perfil de CPU por amostragem
+  if (config != NULL)
+  {
+    profile_file = config->profile_file;
+    profile_period = config->profile_period;
+  }
+  if (profile_file == NULL)
+    profile_file = getenv("PPOS_PROFILE");
+  if (profile_period <= 0 && (env = getenv("PPOS_PROFILE_PERIOD")) != NULL)
+    profile_period = atoi(env);
+  prof_init(profile_file, profile_period);
+
+  // Análise dos bloqueios
+  offcpu_init((config != NULL && config->offcpu_file != NULL) ? config->offcpu_file
+                                                              : getenv("PPOS_OFFCPU"));
+
+  // Contenção dos semáforos e mutexes
+  lockstat_init((config != NULL && config->lockstat_file != NULL) ? config->lockstat_file
+                                                                  : getenv("PPOS_LOCKSTAT"));
+
+  // Registro de eventos
+  trace_init((config != NULL && config->trace_file != NULL) ? config->trace_file
+                                                            : getenv("PPOS_TRACE"));
+
   // Inicializa o sistema de tempo (preempção)
   timer_init();
 
@@ -356,14 +1531,30 @@ void ppos_init()
   main_task.activations = 1;
 }
 
+// Inicializa o sistema com a configuração padrão
+void ppos_init()
+{
+  ppos_init_config(NULL);
+}
+
+// Ponto de entrada das tarefas: conclui a troca de contexto que as ativou
+// pela primeira vez (ver task_switch) e executa o corpo da tarefa
+static void task_start(void (*start_routine)(void *), void *arg)
+{
+  preempt_enable();
+  start_routine(arg);
+}
+
 // Cria uma nova tarefa
 int task_init(task_t *task, void (*start_routine)(void *), void *arg)
 {
   if (!task)
     return -1;
 
-  // Aloca a pilha
+  // Aloca a pilha (sem preempção: o dispatcher libera pilhas com free())
+  preempt_disable();
   task->stack = malloc(STACKSIZE);
+  preempt_enable();
   if (!task->stack)
   {
     perror("task_init: stack allocation error");
@@ -385,7 +1576,7 @@ int task_init(task_t *task, void (*start_routine)(void *), void *arg)
   task->context.uc_link = &dispatcher_task.context; // Quando terminar, volta para o dispatcher
 
   // Cria o contexto com a função de entrada
-  makecontext(&task->context, (void (*)(void))start_routine, 1, arg);
+  makecontext(&task->context, (void (*)(void))task_start, 2, start_routine, arg);
 
   // Configura os demais campos
   task->id = task_counter++;
@@ -395,8 +1586,32 @@ int task_init(task_t *task, void (*start_routine)(void *), void *arg)
   task->static_prio = DEFAULT_PRIO;
   task->dynamic_prio = DEFAULT_PRIO;
   task->task_type = USER_TASK; // Por padrão, cria como tarefa de usuário
+  task->sched_class = SCHED_CLASS_NORMAL;
+  task->quantum = sched_quantum;
+  task->slice = sched_quantum;
+  task->vruntime = 0;
+  task->deadline_misses = 0;
+  task->dl_throttles = 0;
+  task->mlfq_level = 0;
+  task->mlfq_epoch = 0;
+  task->tickets = DEFAULT_TICKETS;
+  task->pass = 0;
+  task->heap_index = -1;
+  task->group = NULL;
+  task->period_ns = 0;
+  task->timed_out = 0;
+  ktimer_init(&task->timeout, timeout_expired, task);
+  task->releases = 0;
+  task->overruns = 0;
+  task->jitter_sum = 0;
+  task->jitter_max = 0;
+  task->cs_flag = 0;
+  task->cs_pending = 0;
+  task->cs_extensions = 0;
+  task->cs_abuses = 0;
   task->waiting_queue = NULL;  // Inicializa a fila de espera
   task->wake_time = 0;         // Inicializa o campo wake_time
+  task->timer_slack = 0;
 
   // Inicializa os contadores de tempo
   task->execution_time = 0;
@@ -404,10 +1619,26 @@ int task_init(task_t *task, void (*start_routine)(void *), void *arg)
   task->activations = 0;
   task->start_time = systime();
   task->last_activation = 0;
-
-  // Adiciona à fila de prontos
-  queue_append((queue_t **)&ready_queue, (queue_t *)task);
+  task->run_ns = 0;
+  task->cpu_ns = 0;
+  memset(task->perf, 0, sizeof(task->perf));
+  task->voluntary = 0;
+  task->involuntary = 0;
+  task->sleeps = 0;
+  task->throttles = 0;
+  task->preempted = 0;
+  task->block_site = NULL;
+  hist_init(&task->wait_hist);
+  hist_init(&task->wakeup_hist);
+
+  // Adiciona à fila de prontos (a política trata a nova tarefa como acordada)
+  preempt_disable();
+  task_list_add(task);
+  ready_wake(task);
+  task->woken = 0; // Tarefa nova: não conta como despertar
   user_tasks_count++;
+  PROBE3(task__create, task->id, task_getprio(task), ready_total());
+  preempt_enable();
 
   return task->id;
 }
@@ -418,6 +1649,11 @@ int task_switch(task_t *task)
   if (!task)
     return -1;
 
+  // Sem preempção durante a troca: um tick que chegasse com current_task já
+  // apontando para a nova tarefa, mas antes de swapcontext restaurar seus
+  // registradores, salvaria um contexto incompleto por cima do dela
+  preempt_disable();
+
   task_t *old = current_task;
   current_task = task;
 
@@ -430,49 +1666,98 @@ int task_switch(task_t *task)
   // Salva o tempo da última ativação
   task->last_activation = systime();
 
+  // Cobra da tarefa que sai o tempo em que ela executou
+  account(old);
+  TRACE(TRACE_SWITCH, old->id, task->id);
+  PROBE4(task__switch, old->id, task->id, task_getprio(task), ready_total());
+  switch_count++;
+  if (old->preempted)
+  {
+    old->involuntary++;
+    old->preempted = 0;
+  }
+  else
+    old->voluntary++;
+
   if (swapcontext(&old->context, &task->context) == -1)
   {
+    preempt_enable();
     perror("task_switch: swapcontext error");
     return -1;
   }
 
+  // A troca só termina quando a tarefa volta a executar aqui
+  preempt_enable();
   return 0;
 }
 
 // Finaliza a tarefa atual
 void task_exit(int exit_code)
 {
+  int i;
+
   current_task->exit_code = exit_code;
 
   // Calcula o tempo total de execução da tarefa
   current_task->execution_time = systime() - current_task->start_time;
 
-  // Acorda todas as tarefas que estavam esperando por esta tarefa
+  // Acorda todas as tarefas que estavam esperando por esta tarefa; sem
+  // preempção até marcá-la terminada, senão uma task_wait() feita nesse
+  // intervalo (por uma tarefa de tempo real que acordou) não seria atendida
+  preempt_disable();
   while (current_task->waiting_queue != NULL)
   {
     task_t *waiting_task = current_task->waiting_queue;
     task_awake(waiting_task, &(current_task->waiting_queue));
   }
 
-  // Imprime as estatísticas da tarefa
-  printf("Task %d exit: running time %6d ms, cpu time %6d ms, %d activations\n",
+  // Imprime as estatísticas da tarefa (e os prazos perdidos, se for EDF,
+  // ou as liberações, se for periódica); ainda sem preempção, pois outra
+  // tarefa que use stdout ficaria bloqueada na trava que esta detém
+  account(current_task);
+  TRACE(TRACE_EXIT, current_task->id, exit_code);
+  PROBE3(task__exit, current_task->id, exit_code, current_task->run_ns);
+  printf("Task %d exit: running time %6d ms, cpu time %6d ms (host %6llu ms), %d activations",
          current_task->id, current_task->execution_time, current_task->processor_time,
-         current_task->activations);
+         current_task->cpu_ns / NS_PER_MS, current_task->activations);
+  if (current_task->sched_class == SCHED_CLASS_DEADLINE)
+  {
+    printf(", %d deadline misses, %d throttles", current_task->deadline_misses,
+           current_task->dl_throttles);
+    sched_dl_release(current_task);
+  }
+  if (current_task->releases > 0)
+    printf(", %d releases, %d overruns, jitter avg %llu us max %llu us",
+           current_task->releases, current_task->overruns,
+           current_task->jitter_sum / current_task->releases / 1000,
+           current_task->jitter_max / 1000);
+  if (current_task->wait_hist.count > 0)
+    printf(", wait p50/p99/p999 %llu/%llu/%llu us",
+           hist_percentile(&current_task->wait_hist, 50) / 1000,
+           hist_percentile(&current_task->wait_hist, 99) / 1000,
+           hist_percentile(&current_task->wait_hist, 99.9) / 1000);
+  for (i = 0; i < PERF_COUNTERS; i++)
+    if (perf_name(i) != NULL)
+      printf(", %s %llu", perf_name(i), current_task->perf[i]);
+  printf("\n");
 
   if (current_task == &main_task)
   {
-    // Se main está saindo e ainda há tarefas de usuário, vai para o dispatcher
-    if (user_tasks_count > 0)
-    {
-      task_switch(&dispatcher_task);
-    }
-    // Se não houver mais tarefas, termina o programa
+    // A main deixa de contar como tarefa de usuário e passa a CPU ao
+    // dispatcher, que escalona as tarefas restantes e volta aqui ao encerrar
+    user_tasks_count--;
+    task_list_remove(&main_task);
+    preempt_enable();
+    task_switch(&dispatcher_task);
+
+    // Sem mais tarefas, termina o programa
     exit(exit_code);
   }
   else
   {
-    // Marca como terminada
+    // Marca como terminada (não é mais preemptada pelo tick)
     current_task->status = TASK_TERMINATED;
+    preempt_enable();
 
     // Volta para o dispatcher
     task_switch(&dispatcher_task);
@@ -484,9 +1769,22 @@ void task_yield()
 {
   // Marca tarefa como pronta e devolve o controle ao dispatcher
   current_task->status = TASK_READY;
+  PROBE3(task__yield, current_task->id, task_getprio(current_task), ready_total());
   task_switch(&dispatcher_task);
 }
 
+// Impede a preempção da tarefa atual
+void preempt_disable()
+{
+  preempt_count++;
+}
+
+// Volta a permitir a preempção da tarefa atual
+void preempt_enable()
+{
+  preempt_count--;
+}
+
 // Retorna o ID da tarefa atual
 int task_id()
 {
@@ -496,14 +1794,27 @@ int task_id()
 // Suspende a tarefa atual
 void task_suspend(task_t **queue)
 {
+  block_mark(OFFCPU_SUSPEND, queue, __builtin_return_address(0));
+  preempt_disable();
+
   // Se a tarefa atual está na fila de prontas, remove dela
   if (current_task->status == TASK_READY)
   {
-    queue_remove(&ready_queue, (queue_t *)current_task);
+    ready_remove(current_task);
   }
 
+  task_suspend_locked(queue);
+}
+
+// Suspende a tarefa atual, com a preempção desabilitada
+void task_suspend_locked(task_t **queue)
+{
+  block_mark(OFFCPU_SUSPEND, queue, __builtin_return_address(0));
+
   // Ajusta o status da tarefa atual para suspensa
   current_task->status = TASK_SUSPENDED;
+  TRACE(TRACE_SUSPEND, current_task->id, 0);
+  PROBE3(task__suspend, current_task->id, queue, ready_total());
 
   // Se a fila não é nula, insere a tarefa atual nela
   if (queue != NULL)
@@ -511,8 +1822,13 @@ void task_suspend(task_t **queue)
     queue_append((queue_t **)queue, (queue_t *)current_task);
   }
 
+  // Suspensa, a tarefa não é mais preemptada pelo tick
+  preempt_enable();
+
   // Retorna ao dispatcher
+  block_begin();
   task_switch(&dispatcher_task);
+  block_end();
 }
 
 // Acorda uma tarefa que está suspensa em uma dada fila
@@ -521,21 +1837,94 @@ void task_awake(task_t *task, task_t **queue)
   if (task == NULL)
     return;
 
+  // As filas de prontas são compartilhadas com o dispatcher
+  preempt_disable();
+
   // Se a fila não é nula, retira a tarefa dessa fila
   if (queue != NULL && *queue != NULL)
   {
     queue_remove((queue_t **)queue, (queue_t *)task);
   }
 
-  // Ajusta o status da tarefa para pronta
-  task->status = TASK_READY;
-
-  // Insere a tarefa na fila de tarefas prontas
-  queue_append(&ready_queue, (queue_t *)task);
+  // Ajusta o status da tarefa para pronta e a insere na fila de prontas
+  ready_wake(task);
+  TRACE(TRACE_WAKE, task->id, current_task->id);
+  PROBE3(task__awake, task->id, current_task->id, ready_total());
+  preempt_enable();
 
   // Continua a tarefa atual (não retorna ao dispatcher)
 }
 
+// Suspende a tarefa atual em uma fila por até timeout_ms
+int task_suspend_timeout(task_t **queue, int timeout_ms)
+{
+  if (timeout_ms == 0)
+    return PPOS_ETIMEDOUT;
+
+  block_mark(OFFCPU_SUSPEND, queue, __builtin_return_address(0));
+  preempt_disable();
+  return task_suspend_timeout_locked(queue, timeout_ms, NULL, NULL);
+}
+
+// Suspende a tarefa atual por até timeout_ms, com a preempção desabilitada
+int task_suspend_timeout_locked(task_t **queue, int timeout_ms, void (*undo)(void *),
+                                void *object)
+{
+  task_t *task = current_task;
+
+  // Prazo nulo: não bloqueia (descarta o bloqueio marcado pelo chamador)
+  if (timeout_ms == 0)
+  {
+    if (undo != NULL)
+      undo(object);
+    preempt_enable();
+    block_end();
+    return PPOS_ETIMEDOUT;
+  }
+
+  block_mark(OFFCPU_SUSPEND, queue, __builtin_return_address(0));
+  task->timed_out = 0;
+  task->timeout_queue = queue;
+  task->timeout_undo = undo;
+  task->timeout_object = object;
+  task->timeout.slack = task->timer_slack / NS_PER_MS;
+  if (timeout_ms > 0)
+    ktimer_arm(&task->timeout, timeout_ms);
+
+  task_suspend_locked(queue);
+
+  ktimer_cancel(&task->timeout);
+  return task->timed_out ? PPOS_ETIMEDOUT : 0;
+}
+
+// A tarefa corrente aguarda o encerramento de outra task, por até timeout_ms
+int task_wait_timeout(task_t *task, int timeout_ms, int *exit_code)
+{
+  if (task == NULL)
+    return -1;
+
+  // Sem preempção entre a verificação e a entrada na fila (ver task_exit)
+  preempt_disable();
+  if (task->status != TASK_TERMINATED)
+  {
+    block_mark(OFFCPU_WAIT, task, __builtin_return_address(0));
+    if (task_suspend_timeout_locked(&task->waiting_queue, timeout_ms, NULL, NULL) ==
+        PPOS_ETIMEDOUT)
+    {
+      block_end();
+      return PPOS_ETIMEDOUT;
+    }
+    block_end();
+  }
+  else
+    preempt_enable();
+
+  if (exit_code != NULL)
+    *exit_code = task->exit_code;
+
+  return 0;
+}
+
 // A tarefa corrente aguarda o encerramento de outra task
 int task_wait(task_t *task)
 {
@@ -543,21 +1932,29 @@ int task_wait(task_t *task)
   if (task == NULL)
     return -1;
 
-  // Se a tarefa já terminou, retorna o código de saída imediatamente
+  // Se a tarefa já terminou, retorna o código de saída imediatamente (sem
+  // preempção entre a verificação e a entrada na fila, ver task_exit)
+  preempt_disable();
   if (task->status == TASK_TERMINATED)
   {
     int exit_code = task->exit_code;
+    preempt_enable();
     return exit_code;
   }
 
+  block_mark(OFFCPU_WAIT, task, __builtin_return_address(0));
+
   // Marca a tarefa atual como suspensa
   current_task->status = TASK_SUSPENDED;
 
   // Adiciona a tarefa atual na fila de espera da tarefa especificada
   queue_append((queue_t **)&(task->waiting_queue), (queue_t *)current_task);
+  preempt_enable();
 
   // Retorna ao dispatcher
+  block_begin();
   task_switch(&dispatcher_task);
+  block_end();
 
   // Quando a tarefa atual for acordada, retorna o código de saída da tarefa esperada
   return task->exit_code;
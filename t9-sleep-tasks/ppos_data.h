@@ -2,6 +2,10 @@
 #define __PPOS_DATA__
 
 #include <ucontext.h>
+#include "rbtree.h"
+#include "hist.h"
+#include "ppos_perf.h"
+#include "ppos_lockstat.h"
 
 // Estados das tarefas
 #define TASK_READY 0
@@ -13,6 +17,39 @@
 #define SYSTEM_TASK 0 // Tarefa de sistema (não preemptável)
 #define USER_TASK 1   // Tarefa de usuário (preemptável)
 
+// Classes de escalonamento (em ordem crescente de precedência)
+#define SCHED_CLASS_NORMAL 0 // Prioridade com envelhecimento e quantum global
+#define SCHED_CLASS_FIFO 1   // Tempo real: executa até bloquear ou liberar a CPU
+#define SCHED_CLASS_RR 2     // Tempo real: round-robin com quantum próprio
+#define SCHED_CLASS_DEADLINE 3 // Tempo real por prazo (EDF), com orçamento por período
+
+// Grupo de tarefas com controle de banda de CPU: as tarefas do grupo (e de
+// seus subgrupos) podem usar até "quota" ms de CPU a cada "period" ms
+typedef struct task_group_t
+{
+  struct task_group_t *parent; // Grupo pai (NULL na raiz da hierarquia)
+  int quota;                   // Cota de CPU por período (ms; <= 0: ilimitada)
+  int period;                  // Período de reposição da cota (ms)
+  unsigned long long period_start;   // Início do período atual (ns)
+  unsigned long long usage;          // CPU consumida no período atual (ns)
+  int throttled;                     // Cota esgotada: tarefas aguardam o próximo período
+  unsigned long long throttle_start; // Momento em que a cota se esgotou (ns)
+  unsigned long long throttled_time; // Tempo total com a cota esgotada (ns)
+  unsigned int throttle_count;       // Número de vezes que a cota se esgotou
+} task_group_t;
+
+// Temporizador do núcleo (ver ktimer_arm): ao vencer, o dispatcher chama
+// callback(timer, arg)
+typedef struct ktimer_t
+{
+  struct ktimer_t *prev, *next; // Encadeamento na posição da roda de tempo
+  struct ktimer_t **slot;       // Posição da roda em que está (NULL: desarmado)
+  unsigned long long expires;   // Tick de vencimento
+  unsigned int slack;           // Folga (em ticks): o vencimento é adiado ao próximo múltiplo
+  void (*callback)(struct ktimer_t *timer, void *arg);
+  void *arg;
+} ktimer_t;
+
 // Estrutura do TCB (Task Control Block)
 typedef struct task_t
 {
@@ -25,30 +62,116 @@ typedef struct task_t
   int static_prio;            // Prioridade estática (-20 a +20)
   int dynamic_prio;           // Prioridade dinâmica (para envelhecimento)
   int task_type;              // Tipo da tarefa (SYSTEM_TASK ou USER_TASK)
+  int sched_class;            // Classe de escalonamento (SCHED_CLASS_*)
+  int quantum;                // Quantum da tarefa (em ticks, usado pela classe RR)
+  int slice;                  // Ticks restantes da fatia de tempo atual
+  task_group_t *group;        // Grupo de controle de banda (ou NULL)
+
+  // Extensão da fatia de tempo para seções críticas curtas
+  volatile int cs_flag;       // Ligado pela tarefa durante a seção crítica
+  int cs_pending;             // Preempção adiada, a tarefa deve liberar a CPU
+  int cs_ext_left;            // Ticks restantes da extensão concedida
+  unsigned int cs_extensions; // Extensões concedidas
+  unsigned int cs_abuses;     // Extensões ultrapassadas (preempção forçada)
+
+  // Campos da política "cfs"
+  unsigned long long vruntime; // Tempo virtual de execução (ns ponderados pelo peso)
+  int weight;                  // Peso usado enquanto a tarefa está na árvore
+  rb_node_t rb_node;           // Nó na árvore de prontas (cfs: vruntime, EDF: prazo)
+                               // ou de adormecidas (wake_time)
+
+  // Campos da política "mlfq"
+  int mlfq_level;          // Nível atual (0 é o de maior prioridade)
+  unsigned int mlfq_epoch; // Última elevação periódica vista pela tarefa
+
+  // Campos das políticas "stride" e "lottery"
+  int tickets;             // Bilhetes: fatia de CPU proporcional a este valor
+  unsigned long long pass; // Passo acumulado (stride)
+  int heap_index;          // Posição no heap de passos (stride)
+
+  // Campos da classe SCHED_CLASS_DEADLINE (tempos em ms)
+  int dl_period;                // Período de ativação
+  int dl_runtime;               // Tempo de execução reservado por período
+  int dl_deadline;              // Prazo relativo ao início do período
+  unsigned long long dl_release;      // Início do período atual (ns)
+  unsigned long long dl_abs_deadline; // Prazo absoluto do job atual (ns)
+  int dl_budget;                // Orçamento restante no período (em ticks)
+  int dl_missed;                // O job atual já foi contado como prazo perdido
+  int dl_throttled;             // Bloqueada por esgotar o orçamento
+  unsigned int deadline_misses; // Jobs ainda não concluídos no prazo absoluto
+  unsigned int dl_throttles;    // Vezes que o orçamento se esgotou no período
 
   // Campos para contabilização de uso
   unsigned int execution_time;  // Tempo total de execução (em ms)
-  unsigned int processor_time;  // Tempo de processador (em ms)
+  unsigned int processor_time;  // Tempo de processador (em ms, derivado de run_ns)
   unsigned int activations;     // Número de ativações
   unsigned int start_time;      // Momento de início da tarefa
   unsigned int last_activation; // Momento da última ativação
+  unsigned long long run_ns;    // Tempo em execução (em ns), medido nas trocas
+  unsigned long long cpu_ns;    // Tempo de CPU do processo hospedeiro consumido
+                                // enquanto a tarefa executava (em ns)
+  unsigned long long perf[PERF_COUNTERS]; // Contadores de desempenho (ver ppos_perf.h)
+  unsigned int voluntary;       // Trocas em que a tarefa deixou a CPU por conta própria
+  unsigned int involuntary;     // Trocas por preempção
+  unsigned int sleeps;          // Vezes que a tarefa adormeceu
+  unsigned int throttles;       // Vezes que foi contida (orçamento ou cota esgotados)
+  int preempted;                // A troca em curso é uma preempção
+
+  // Bloqueio em curso, para a análise fora da CPU (ver ppos_offcpu.h)
+  int block_reason;               // Motivo (OFFCPU_*)
+  void *block_object;             // Objeto esperado
+  void *block_site;               // Local da chamada que bloqueou (NULL: nenhum)
+  unsigned long long block_start; // Início do bloqueio (ns; 0: não começou)
+
+  // Lista de todas as tarefas existentes (ver ppos_stats_snapshot)
+  struct task_t *all_prev, *all_next;
+
+  // Latências de escalonamento (em ns)
+  unsigned long long ready_since; // Momento em que entrou no conjunto de prontas
+  unsigned long long woken_at;    // Momento do último despertar
+  int woken;                      // Acordou e ainda não executou
+  hist_t wait_hist;               // Espera entre ficar pronta e executar
+  hist_t wakeup_hist;             // Espera entre acordar e executar
 
   // Campo para sincronização
   struct task_t *waiting_queue; // Fila de tarefas esperando por esta tarefa
 
   // Campo para task_sleep
-  unsigned int wake_time; // Momento em que a tarefa deve acordar (em ms)
+  unsigned long long wake_time;   // Momento em que a tarefa deve acordar (em ns)
+  unsigned long long timer_slack; // Folga permitida nos despertares (em ns)
+
+  // Campos para esperas com prazo (task_suspend_timeout)
+  ktimer_t timeout;              // Prazo da espera atual
+  struct task_t **timeout_queue; // Fila em que a tarefa está bloqueada
+  void (*timeout_undo)(void *);  // Desfaz a requisição ao objeto, no prazo
+  void *timeout_object;          // Objeto da espera, para timeout_undo
+  int timed_out;                 // A última espera terminou pelo prazo
+
+  // Campos das tarefas periódicas (tempos em ns)
+  unsigned long long period_ns;    // Período de liberação (0: não periódica)
+  unsigned long long next_release; // Liberação atual
+  unsigned int releases;           // Liberações atendidas
+  unsigned int overruns;           // Liberações perdidas por excesso de trabalho
+  unsigned long long jitter_sum;   // Soma dos atrasos de liberação
+  unsigned long long jitter_max;   // Maior atraso de liberação
 } task_t;
 
-// Estruturas para sincronização (vazias por enquanto)
+// Estruturas para sincronização
 typedef struct
 {
-  // A ser implementado
+  int value;             // Contador; negativo: número de tarefas na fila
+  int active;            // O semáforo existe (não foi destruído)
+  struct task_t *queue;  // Tarefas bloqueadas, em ordem de chegada
+  lock_stats_t stats;    // Estatísticas de contenção (ver ppos_lockstat.h)
 } semaphore_t;
 
 typedef struct
 {
-  // A ser implementado
+  int active;            // O mutex existe (não foi destruído)
+  int locked;            // O mutex está ocupado
+  int owner;             // ID da tarefa que o detém
+  struct task_t *queue;  // Tarefas bloqueadas, em ordem de chegada
+  lock_stats_t stats;    // Estatísticas de contenção (ver ppos_lockstat.h)
 } mutex_t;
 
 typedef struct
@@ -0,0 +1,327 @@
+// PingPongOS - PingPong Operating System
+
+// Extensões da interface do núcleo, não previstas em ppos.h
+// (ppos.h é sobrescrito nos testes, por isso as novas chamadas ficam aqui)
+
+#ifndef __PPOS_EXT__
+#define __PPOS_EXT__
+
+#include "ppos_data.h"
+
+// funções gerais ==============================================================
+
+// configuração do núcleo; campos zerados (ou NULL) usam o valor das
+// variáveis de ambiente indicadas ou, na falta delas, o padrão
+typedef struct
+{
+  const char *sched_policy; // política da classe normal: "prio" (padrão),
+                            // "fcfs", "rr", "cfs", "mlfq", "stride" ou
+                            // "lottery" (PPOS_SCHED)
+  int quantum;              // quantum em ticks (PPOS_QUANTUM, padrão 20)
+  int aging;                // fator de envelhecimento da política "prio" (-1)
+  int mlfq_levels;          // níveis da política "mlfq" (4, até MLFQ_MAX_LEVELS)
+  int mlfq_boost;           // período da elevação da política "mlfq" (1000 ticks)
+  int target_latency;       // latência alvo (ms) do ajuste automático do quantum:
+                            // toda tarefa pronta executa dentro desse intervalo
+                            // (PPOS_LATENCY; 0: quantum fixo)
+  int min_granularity;      // quantum mínimo do ajuste automático (1 tick)
+  const char *tick_source;  // origem dos ticks: "signal" (padrão, SIGALRM a
+                            // cada tick) ou "timerfd" (ticks lidos de um
+                            // timerfd nos pontos seguros e SIGALRM só no fim
+                            // da fatia) (PPOS_TICK)
+  const char *tick_clock;   // relógio dos ticks e quanta: "real" (padrão),
+                            // "virtual" (CPU em modo usuário) ou "prof"
+                            // (CPU total do processo) (PPOS_TICK_CLOCK); os
+                            // relógios de CPU avançam em passos de vários
+                            // ticks, por isso a classe EDF e a extensão da
+                            // fatia exigem o relógio real
+  const char *trace_file;   // arquivo em que o registro de eventos, ligado
+                            // desde a inicialização, é salvo ao fim do
+                            // processo (PPOS_TRACE; NULL: desligado)
+  const char *stats_file;   // arquivo em que as estatísticas são publicadas
+                            // em memória compartilhada, para a ferramenta
+                            // ppos-top (PPOS_STATS_FILE; NULL: desligado)
+  const char *profile_file; // arquivo em que as amostras do perfil de CPU
+                            // são salvas ao fim do processo, para a
+                            // ferramenta ppos-prof (PPOS_PROFILE; NULL: desligado)
+  int profile_period;       // ticks entre amostras do perfil, que limita
+                            // seu custo (PPOS_PROFILE_PERIOD, padrão 1)
+  const char *offcpu_file;  // arquivo em que o relatório dos bloqueios das
+                            // tarefas (motivo, objeto, local da chamada e
+                            // duração, agregados por local) é salvo ao fim
+                            // do processo (PPOS_OFFCPU; NULL: desligado)
+  int perf_counters;        // abre os contadores de desempenho do processo
+                            // e os cobra das tarefas a cada troca (PPOS_PERF=1)
+  const char *lockstat_file; // arquivo em que as estatísticas de contenção
+                             // dos semáforos e mutexes são salvas ao fim do
+                             // processo (PPOS_LOCKSTAT; NULL: desligado)
+} ppos_config_t;
+
+// Inicializa o sistema operacional com a configuração indicada (ou NULL);
+// substitui ppos_init() no inicio do main()
+void ppos_init_config(const ppos_config_t *config);
+
+// relógio do sistema em microssegundos e em nanossegundos (ver systime())
+unsigned long long systime_us();
+unsigned long long systime_ns();
+
+// divisão do tempo desde a inicialização (em ns), medida nas trocas de contexto
+typedef struct
+{
+  unsigned long long user_ns;   // executando tarefas de usuário
+  unsigned long long kernel_ns; // executando o dispatcher
+  unsigned long long idle_ns;   // aguardando, sem tarefas prontas
+} cpu_stats_t;
+
+// preenche a divisão do tempo do processador. Retorna 0 ou erro (<0).
+int ppos_cpu_stats(cpu_stats_t *stats);
+
+// estatísticas de uma tarefa (ver ppos_stats_snapshot)
+typedef struct
+{
+  int id;                      // identificador
+  int status;                  // estado (TASK_*)
+  int task_type;               // USER_TASK ou SYSTEM_TASK
+  int sched_class;             // classe de escalonamento (SCHED_CLASS_*)
+  int static_prio;             // prioridade estática
+  int dynamic_prio;            // prioridade dinâmica
+  unsigned long long run_ns;   // tempo em execução (ns)
+  unsigned long long cpu_ns;   // tempo de CPU do hospedeiro consumido (ns)
+  unsigned int activations;    // ativações
+  unsigned int voluntary;      // trocas em que deixou a CPU por conta própria
+  unsigned int involuntary;    // trocas por preempção
+  unsigned int sleeps;         // vezes que adormeceu
+  unsigned int throttles;      // vezes que foi contida (orçamento EDF ou cota)
+  unsigned long long wait_ns;  // tempo total na fila de prontas (ns)
+} task_stats_t;
+
+// estatísticas do sistema (ver ppos_stats_snapshot)
+typedef struct
+{
+  unsigned long long uptime_ns; // tempo desde a inicialização
+  int tasks;                    // tarefas existentes (inclusive main e dispatcher)
+  int user_tasks;               // tarefas de usuário ainda não terminadas
+  int ready;                    // tarefas prontas
+  int sleeping;                 // tarefas adormecidas
+  unsigned long long switches;  // trocas de contexto
+  unsigned long switch_rate;    // trocas por segundo desde o snapshot anterior
+  unsigned long long ticks;     // ticks do relógio
+  unsigned long long user_ns;   // tempo em tarefas de usuário
+  unsigned long long kernel_ns; // tempo no dispatcher
+  unsigned long long idle_ns;   // tempo sem tarefas prontas
+  int quantum;                  // quantum em uso (ticks)
+} ppos_stats_t;
+
+// preenche, a qualquer momento, as estatísticas do sistema e as de até
+// max_tasks tarefas (em tasks). Retorna o número de tarefas preenchidas
+// (stats->tasks indica quantas existem) ou erro (<0).
+int ppos_stats_snapshot(ppos_stats_t *stats, task_stats_t *tasks, int max_tasks);
+
+// latências de escalonamento, em histogramas log-lineares (ver hist.h)
+#define LATENCY_WAIT 0     // entre ficar pronta e executar
+#define LATENCY_WAKEUP 1   // entre acordar (task_awake ou fim do sono) e executar
+#define LATENCY_DECISION 2 // duração da escolha do escalonador (só do sistema)
+
+typedef struct
+{
+  unsigned long long count; // número de amostras
+  unsigned long long avg;   // média (ns)
+  unsigned long long p50;   // mediana (ns)
+  unsigned long long p99;   // percentil 99 (ns)
+  unsigned long long p999;  // percentil 99,9 (ns)
+  unsigned long long max;   // maior amostra (ns)
+} latency_stats_t;
+
+// preenche os percentis de um tipo de latência (LATENCY_*), de todas as
+// tarefas (task==NULL) ou de uma tarefa. Retorna 0 ou erro (<0).
+int ppos_latency_stats(task_t *task, int kind, latency_stats_t *stats);
+
+// suspende a tarefa atual por t microssegundos
+void task_sleep_us(long t);
+
+// suspende a tarefa atual até o instante indicado de systime_ns()
+void task_sleep_until(unsigned long long abs_time);
+
+// define a folga (em microssegundos) dos despertares de uma tarefa (ou da
+// atual, se task==NULL): cada despertar é adiado até o próximo múltiplo da
+// folga, de modo que tarefas com a mesma folga acordem juntas (padrão 0).
+// Retorna 0 ou erro (<0).
+int task_setslack(task_t *task, long slack_us);
+
+// retorna a folga dos despertares de uma tarefa (ou da atual), em microssegundos
+long task_getslack(task_t *task);
+
+// temporizadores e esperas com prazo ==========================================
+
+// erro retornado pelas esperas cujo prazo expirou
+#define PPOS_ETIMEDOUT -110
+
+// inicializa um temporizador desarmado, que chama callback(timer, arg) no
+// contexto do dispatcher ao vencer
+void ktimer_init(ktimer_t *timer, void (*callback)(ktimer_t *timer, void *arg), void *arg);
+
+// arma (ou rearma) o temporizador para vencer daqui a timeout_ms (mínimo de
+// um tick). Custo O(1). Retorna 0 ou erro (<0).
+int ktimer_arm(ktimer_t *timer, int timeout_ms);
+
+// cancela o temporizador. Custo O(1). Retorna 1 se ele ainda estava armado.
+int ktimer_cancel(ktimer_t *timer);
+
+// suspende a tarefa atual na fila indicada por até timeout_ms (< 0: sem
+// prazo; 0: não bloqueia). Retorna 0 se ela foi acordada por task_awake()
+// ou PPOS_ETIMEDOUT. Base para as esperas com prazo das primitivas de IPC.
+int task_suspend_timeout(task_t **queue, int timeout_ms);
+
+// como task_wait(), mas desiste após timeout_ms. Retorna 0 se a tarefa
+// terminou, guardando seu código de saída em *exit_code (se não nulo),
+// PPOS_ETIMEDOUT ou erro (<0); o código de saída não passa pelo retorno, onde
+// poderia ser confundido com PPOS_ETIMEDOUT
+int task_wait_timeout(task_t *task, int timeout_ms, int *exit_code);
+
+// como sem_down() e mutex_lock(), mas desistem após timeout_ms (< 0: sem
+// prazo; 0: só adquirem se não precisarem esperar), retornando PPOS_ETIMEDOUT
+int sem_down_timeout(semaphore_t *s, int timeout_ms);
+int mutex_lock_timeout(mutex_t *m, int timeout_ms);
+
+// tarefas periódicas ==========================================================
+
+// torna a tarefa (ou a atual, se task==NULL) periódica, com o período
+// indicado em microssegundos (0: deixa de ser periódica); o período atual
+// começa agora. Retorna 0 ou erro (<0).
+int task_set_period(task_t *task, long period_us);
+
+// suspende a tarefa atual até a próxima liberação periódica, contada a partir
+// da anterior (e não do fim do trabalho). Retorna o número de liberações
+// perdidas por excesso de trabalho (0 no caso normal) ou erro (<0).
+int task_wait_period();
+
+// estatísticas de uma tarefa periódica
+typedef struct
+{
+  long period_us;                   // período (us)
+  unsigned int releases;            // liberações atendidas
+  unsigned int overruns;            // liberações perdidas
+  unsigned long long jitter_avg_ns; // atraso médio entre liberação e execução
+  unsigned long long jitter_max_ns; // maior atraso entre liberação e execução
+} period_stats_t;
+
+// preenche as estatísticas periódicas da tarefa (ou da atual, se task==NULL).
+// Retorna 0 ou erro (<0).
+int task_period_stats(task_t *task, period_stats_t *stats);
+
+// operações de escalonamento ==================================================
+
+// define a classe de escalonamento (SCHED_CLASS_*) de uma tarefa
+// (ou a tarefa atual). Retorna 0 ou erro (<0).
+int task_setclass(task_t *task, int sched_class);
+
+// retorna a classe de escalonamento de uma tarefa (ou a tarefa atual)
+int task_getclass(task_t *task);
+
+// define o quantum (em ticks) de uma tarefa da classe RR (ou a tarefa atual).
+// Retorna 0 ou erro (<0).
+int task_setquantum(task_t *task, int quantum);
+
+// retorna o quantum (em ticks) de uma tarefa (ou a tarefa atual)
+int task_getquantum(task_t *task);
+
+// a tarefa atual entra em uma seção crítica curta (ex.: segura uma trava de
+// usuário): se a fatia de tempo acabar, a preempção é adiada por no máximo
+// SLICE_EXTENSION ticks (só com o relógio real dos ticks; com os relógios de
+// CPU não há extensão). Equivale a ligar task->cs_flag.
+void task_cs_begin();
+
+// a tarefa atual sai da seção crítica; se a preempção foi adiada, libera
+// a CPU imediatamente
+void task_cs_end();
+
+// estado do ajuste automático do quantum
+typedef struct
+{
+  int enabled;                      // ajuste ativo (target_latency > 0)
+  int quantum;                      // quantum em uso (ticks)
+  int target_latency;               // latência alvo (ms)
+  int min_granularity;              // quantum mínimo (ticks)
+  unsigned long switch_overhead_ns; // custo médio observado de uma decisão do dispatcher
+  unsigned long updates;            // número de mudanças do quantum
+} quantum_stats_t;
+
+// preenche o estado do ajuste automático do quantum. Retorna 0 ou erro (<0).
+int ppos_quantum_stats(quantum_stats_t *stats);
+
+// define o número de bilhetes de uma tarefa (ou a tarefa atual), usado pelas
+// políticas "stride" e "lottery" (padrão: 100). Retorna 0 ou erro (<0).
+int task_settickets(task_t *task, int tickets);
+
+// retorna o número de bilhetes de uma tarefa (ou a tarefa atual)
+int task_gettickets(task_t *task);
+
+// controle de banda =========================================================
+
+// inicializa um grupo de tarefas, dentro do grupo "parent" (ou NULL), com
+// cota de quota_ms de CPU a cada period_ms (quota_ms <= 0: sem limite).
+// Retorna 0 ou erro (<0).
+int group_init(task_group_t *group, task_group_t *parent, int quota_ms, int period_ms);
+
+// altera a cota e o período de um grupo. Retorna 0 ou erro (<0).
+int group_setquota(task_group_t *group, int quota_ms, int period_ms);
+
+// coloca uma tarefa (ou a tarefa atual) no grupo indicado (NULL: sem grupo).
+// Retorna 0 ou erro (<0).
+int task_setgroup(task_t *task, task_group_t *group);
+
+// retorna o tempo total (ms) em que o grupo ficou com a cota esgotada
+unsigned int group_throttled_time(task_group_t *group);
+
+// estatísticas da política "mlfq", por nível
+#define MLFQ_MAX_LEVELS 8
+
+typedef struct
+{
+  int levels;                                 // número de níveis em uso
+  int quantum[MLFQ_MAX_LEVELS];               // quantum de cada nível (ticks)
+  int ready[MLFQ_MAX_LEVELS];                 // tarefas prontas em cada nível
+  unsigned long ticks[MLFQ_MAX_LEVELS];       // ticks de CPU consumidos no nível
+  unsigned long dispatches[MLFQ_MAX_LEVELS];  // ativações de tarefas do nível
+  unsigned long demotions[MLFQ_MAX_LEVELS];   // rebaixamentos a partir do nível
+  unsigned long boosts;                       // elevações periódicas realizadas
+} mlfq_stats_t;
+
+// preenche as estatísticas da política "mlfq".
+// Retorna 0, ou erro (<0) se a classe normal usa outra política.
+int ppos_mlfq_stats(mlfq_stats_t *stats);
+
+// coloca uma tarefa (ou a tarefa atual) na classe SCHED_CLASS_DEADLINE:
+// a cada period_ms ela recebe runtime_ms de CPU, a ser usado em até
+// deadline_ms (0: igual ao período). Retorna 0, ou erro (<0) se os parâmetros
+// forem inválidos, se a utilização total das tarefas EDF passar do limite ou
+// se o relógio dos ticks não for o real (PPOS_TICK_CLOCK).
+int task_setdeadline(task_t *task, int period_ms, int runtime_ms, int deadline_ms);
+
+// contenção dos semáforos e mutexes ===========================================
+
+// dá nome ao semáforo/mutex nas estatísticas de contenção (ver PPOS_LOCKSTAT).
+// Retorna 0 ou erro (<0).
+int sem_setname(semaphore_t *s, const char *name);
+int mutex_setname(mutex_t *m, const char *name);
+
+// copia as estatísticas de contenção do semáforo/mutex (zeradas se o registro
+// estiver desligado). Retorna 0 ou erro (<0).
+int sem_getstats(semaphore_t *s, lock_stats_t *stats);
+int mutex_getstats(mutex_t *m, lock_stats_t *stats);
+
+// registro de eventos =========================================================
+
+// liga o registro de eventos do escalonador (trocas de contexto, suspensões,
+// despertares, preempções) num anel de tamanho fixo, descartando o anterior;
+// desligado, o custo é um teste por evento
+void trace_start();
+
+// desliga o registro de eventos, preservando o anel
+void trace_stop();
+
+// salva o anel no arquivo indicado, em formato binário (ver ppos_trace.h e a
+// ferramenta ppos-trace). Retorna 0 ou erro (<0).
+int trace_dump(const char *path);
+
+#endif
@@ -0,0 +1,124 @@
+// PingPongOS - PingPong Operating System
+
+// Controle de banda de CPU por grupos hierárquicos de tarefas.
+// A cota de cada grupo é reposta de forma preguiçosa: o período só é
+// avançado quando o grupo é consultado ou cobrado.
+
+#include "ppos.h"
+#include "ppos_ext.h"
+#include "ppos_sched.h"
+
+// Avança o grupo para o período que contém "now", repondo a cota
+static void group_refresh(task_group_t *group, unsigned long long now)
+{
+  unsigned long long period = group->period * NS_PER_MS;
+  unsigned long long period_end = group->period_start + period;
+
+  if (now < period_end)
+    return;
+
+  // A cota esgotada volta a valer no fim do período
+  if (group->throttled)
+  {
+    group->throttled_time += period_end - group->throttle_start;
+    group->throttled = 0;
+  }
+
+  group->usage = 0;
+  group->period_start += (now - group->period_start) / period * period;
+}
+
+// Inicializa um grupo de tarefas
+int group_init(task_group_t *group, task_group_t *parent, int quota_ms, int period_ms)
+{
+  if (group == NULL || group == parent)
+    return -1;
+
+  group->parent = parent;
+  group->period_start = systime_ns();
+  group->usage = 0;
+  group->throttled = 0;
+  group->throttle_start = 0;
+  group->throttled_time = 0;
+  group->throttle_count = 0;
+
+  return group_setquota(group, quota_ms, period_ms);
+}
+
+// Altera a cota e o período de um grupo
+int group_setquota(task_group_t *group, int quota_ms, int period_ms)
+{
+  if (group == NULL || period_ms <= 0)
+    return -1;
+
+  group->quota = quota_ms;
+  group->period = period_ms;
+
+  return 0;
+}
+
+// Retorna o tempo total em que o grupo ficou com a cota esgotada
+unsigned int group_throttled_time(task_group_t *group)
+{
+  unsigned long long now = systime_ns();
+
+  if (group == NULL)
+    return 0;
+
+  group_refresh(group, now);
+
+  // Inclui o estrangulamento em curso
+  if (group->throttled)
+    return (group->throttled_time + (now - group->throttle_start)) / NS_PER_MS;
+
+  return group->throttled_time / NS_PER_MS;
+}
+
+void group_charge(task_t *task, unsigned long long now)
+{
+  for (task_group_t *group = task->group; group != NULL; group = group->parent)
+  {
+    group_refresh(group, now);
+    group->usage += TICK_NS;
+
+    if (group->quota > 0 && !group->throttled && group->usage >= group->quota * NS_PER_MS)
+    {
+      group->throttled = 1;
+      group->throttle_start = now;
+      group->throttle_count++;
+    }
+  }
+}
+
+int group_quota_ticks(task_t *task, unsigned long long now)
+{
+  unsigned long long left, min_left = 0;
+  int limited = 0;
+
+  for (task_group_t *group = task->group; group != NULL; group = group->parent)
+  {
+    if (group->quota <= 0)
+      continue;
+
+    group_refresh(group, now);
+    left = group->quota * NS_PER_MS;
+    left = (group->usage < left) ? left - group->usage : 0;
+    if (!limited || left < min_left)
+      min_left = left;
+    limited = 1;
+  }
+
+  return limited ? (min_left + TICK_NS - 1) / TICK_NS : -1;
+}
+
+task_group_t *group_throttled(task_t *task, unsigned long long now)
+{
+  for (task_group_t *group = task->group; group != NULL; group = group->parent)
+  {
+    group_refresh(group, now);
+    if (group->throttled)
+      return group;
+  }
+
+  return NULL;
+}
@@ -0,0 +1,204 @@
+// PingPongOS - PingPong Operating System
+
+// Estatísticas de contenção por objeto de sincronização (ver ppos_lockstat.h)
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <dlfcn.h>
+#include "ppos_clock.h"
+#include "ppos_lockstat.h"
+
+int lockstat_enabled = 0;
+
+static lock_stats_t *objects = NULL; // Lista circular dos objetos registrados
+static FILE *report = NULL;
+
+static const char *kind_names[] = {"sem", "mutex"};
+
+// Escreve o local de chamada: função (se exportada) e módulo+deslocamento
+static void site_print(void *site)
+{
+  Dl_info info;
+
+  if (dladdr(site, &info) && info.dli_fbase != NULL)
+  {
+    if (info.dli_sname != NULL)
+      fprintf(report, "%s+0x%lx ", info.dli_sname,
+              (unsigned long)((uintptr_t)site - (uintptr_t)info.dli_saddr));
+    fprintf(report, "(%s+0x%lx)\n", info.dli_fname,
+            (unsigned long)((uintptr_t)site - (uintptr_t)info.dli_fbase));
+  }
+  else
+    fprintf(report, "%p\n", site);
+}
+
+// Salva as estatísticas de um objeto, seguidas dos locais que mais esperaram
+static void stats_print(lock_stats_t *stats)
+{
+  int i;
+
+  fprintf(report, "%-5s %-*s %10lu %10lu %12.3f %10llu %12.3f %10llu\n", kind_names[stats->kind],
+          LOCKSTAT_NAME, stats->name[0] ? stats->name : "(sem nome)", stats->acquisitions,
+          stats->contended, stats->wait_ns / 1e6, stats->wait_max / 1000, stats->hold_ns / 1e6,
+          stats->hold_max / 1000);
+  for (i = 0; i < LOCKSTAT_SITES && stats->sites[i].site != NULL; i++)
+  {
+    fprintf(report, "      %10lu waits %12.3f ms  ", stats->sites[i].count,
+            stats->sites[i].wait_ns / 1e6);
+    site_print(stats->sites[i].site);
+  }
+}
+
+// Salva os objetos ainda existentes
+static void lockstat_atexit()
+{
+  lock_stats_t *stats = objects;
+
+  lockstat_enabled = 0;
+  if (stats != NULL)
+    do
+    {
+      stats_print(stats);
+      stats = stats->next;
+    } while (stats != objects);
+  fclose(report);
+}
+
+// Liga o registro
+void lockstat_init(const char *path)
+{
+  if (path == NULL || *path == '\0')
+    return;
+
+  if ((report = fopen(path, "w")) == NULL)
+  {
+    perror("ppos: lockstat");
+    return;
+  }
+
+  fprintf(report, "# contenção por objeto: tipo, nome, aquisições, aquisições com espera,\n"
+                  "# espera total (ms) e máxima (us), posse total (ms) e máxima (us);\n"
+                  "# abaixo de cada objeto, os locais que mais esperaram\n");
+  atexit(lockstat_atexit);
+  lockstat_enabled = 1;
+}
+
+// Zera as estatísticas e inclui o objeto na lista
+void lockstat_register(lock_stats_t *stats, int kind)
+{
+  memset(stats, 0, sizeof(lock_stats_t));
+  stats->kind = kind;
+  if (!lockstat_enabled)
+    return;
+
+  if (objects == NULL)
+    stats->prev = stats->next = stats;
+  else
+  {
+    stats->next = objects;
+    stats->prev = objects->prev;
+    objects->prev->next = stats;
+    objects->prev = stats;
+  }
+  objects = stats;
+  stats->registered = 1;
+}
+
+// Salva e retira o objeto da lista
+void lockstat_unregister(lock_stats_t *stats)
+{
+  if (!stats->registered)
+    return;
+
+  if (lockstat_enabled)
+    stats_print(stats);
+
+  if (stats->next == stats)
+    objects = NULL;
+  else
+  {
+    stats->prev->next = stats->next;
+    stats->next->prev = stats->prev;
+    if (objects == stats)
+      objects = stats->next;
+  }
+  stats->prev = stats->next = NULL;
+  stats->registered = 0;
+}
+
+// Dá nome ao objeto
+void lockstat_setname(lock_stats_t *stats, const char *name)
+{
+  if (name == NULL)
+    stats->name[0] = '\0';
+  else
+  {
+    strncpy(stats->name, name, LOCKSTAT_NAME - 1);
+    stats->name[LOCKSTAT_NAME - 1] = '\0';
+  }
+}
+
+// Soma a espera ao local de chamada; com a tabela cheia, o local de menor
+// espera cede a posição e o novo herda seus totais (algoritmo "space
+// saving": os locais mais quentes nunca são perdidos, os totais dos demais
+// podem ser superestimados)
+static void site_add(lock_stats_t *stats, void *site, unsigned long long wait_ns)
+{
+  lockstat_site_t *entry;
+  int i;
+
+  // Os locais estão em ordem decrescente de espera: o último é o menor
+  for (i = 0; i < LOCKSTAT_SITES - 1; i++)
+    if (stats->sites[i].site == site || stats->sites[i].site == NULL)
+      break;
+  entry = &stats->sites[i];
+
+  entry->site = site;
+  entry->count++;
+  entry->wait_ns += wait_ns;
+
+  // Restaura a ordem
+  while (entry > stats->sites && entry[-1].wait_ns < entry->wait_ns)
+  {
+    lockstat_site_t swap = entry[-1];
+    entry[-1] = *entry;
+    *entry = swap;
+    entry--;
+  }
+}
+
+// Registra uma aquisição
+void lockstat_acquire(lock_stats_t *stats, unsigned long long wait_ns, void *site)
+{
+  if (!stats->registered)
+    return;
+
+  stats->acquisitions++;
+  stats->acquired_at = clock_ns();
+  if (wait_ns == 0)
+    return;
+
+  stats->contended++;
+  stats->wait_ns += wait_ns;
+  if (wait_ns > stats->wait_max)
+    stats->wait_max = wait_ns;
+  site_add(stats, site, wait_ns);
+}
+
+// Registra uma liberação
+void lockstat_release(lock_stats_t *stats)
+{
+  unsigned long long hold;
+
+  if (!stats->registered || stats->acquired_at == 0)
+    return;
+
+  hold = clock_ns() - stats->acquired_at;
+  stats->hold_ns += hold;
+  if (hold > stats->hold_max)
+    stats->hold_max = hold;
+  stats->acquired_at = 0;
+}
@@ -0,0 +1,70 @@
+// PingPongOS - PingPong Operating System
+
+// Estatísticas de contenção por objeto de sincronização (semáforos e
+// mutexes): aquisições, aquisições que precisaram esperar, tempo de espera
+// total e máximo, tempo de posse e os locais de chamada que mais esperaram.
+// Cada objeto embute um lock_stats_t, que as primitivas atualizam com a
+// preempção desabilitada; com o registro ligado, os objetos existentes são
+// salvos em texto ao fim do processo, e os destruídos antes, ao serem
+// destruídos. Módulo separado porque a identificação dos locais usa dladdr(),
+// que exige _GNU_SOURCE.
+
+#ifndef __PPOS_LOCKSTAT__
+#define __PPOS_LOCKSTAT__
+
+#define LOCKSTAT_SITES 4 // Locais de espera guardados por objeto
+#define LOCKSTAT_NAME 32 // Tamanho máximo do nome, com o terminador
+
+// Tipos de objeto
+#define LOCKSTAT_SEM 0
+#define LOCKSTAT_MUTEX 1
+
+// Um local de chamada que esperou pelo objeto
+typedef struct
+{
+  void *site;                 // Endereço de retorno (NULL: vazio)
+  unsigned long count;        // Esperas
+  unsigned long long wait_ns; // Tempo total de espera
+} lockstat_site_t;
+
+typedef struct lock_stats_t
+{
+  struct lock_stats_t *prev, *next; // Objetos registrados
+  int registered;
+  int kind;                         // LOCKSTAT_*
+  char name[LOCKSTAT_NAME];         // Nome (ver lockstat_setname)
+  unsigned long acquisitions;       // Aquisições
+  unsigned long contended;          // Aquisições que precisaram esperar
+  unsigned long long wait_ns;       // Tempo total de espera
+  unsigned long long wait_max;      // Maior espera
+  unsigned long long hold_ns;       // Tempo total de posse
+  unsigned long long hold_max;      // Maior posse
+  unsigned long long acquired_at;   // Última aquisição (ns; 0: livre)
+  lockstat_site_t sites[LOCKSTAT_SITES]; // Locais que mais esperaram (aproximado)
+} lock_stats_t;
+
+// Registro ligado (ver lockstat_init)
+extern int lockstat_enabled;
+
+// Liga o registro, salvando o relatório em "path" (path NULL ou vazio:
+// desligado; os objetos só guardam o nome)
+void lockstat_init(const char *path);
+
+// Zera as estatísticas de um objeto criado e o inclui no relatório
+void lockstat_register(lock_stats_t *stats, int kind);
+
+// Retira do relatório um objeto destruído, salvando antes suas estatísticas
+void lockstat_unregister(lock_stats_t *stats);
+
+// Dá nome ao objeto no relatório (NULL: sem nome)
+void lockstat_setname(lock_stats_t *stats, const char *name);
+
+// Registra uma aquisição, após esperar "wait_ns" (0: sem contenção) a
+// partir do local "site"
+void lockstat_acquire(lock_stats_t *stats, unsigned long long wait_ns, void *site);
+
+// Registra uma liberação; o tempo de posse conta da última aquisição (num
+// semáforo com várias unidades, é uma aproximação)
+void lockstat_release(lock_stats_t *stats);
+
+#endif
@@ -0,0 +1,138 @@
+// PingPongOS - PingPong Operating System
+
+// Análise fora da CPU (ver ppos_offcpu.h)
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <dlfcn.h>
+#include "hist.h"
+#include "ppos_offcpu.h"
+
+// Bloqueios de um local de chamada por um motivo
+typedef struct
+{
+  void *site;   // Endereço de retorno da chamada que bloqueou (NULL: vazio)
+  int reason;   // OFFCPU_*
+  void *object; // Objeto esperado, se todos os bloqueios esperaram o mesmo
+  int mixed;    // Os bloqueios esperaram objetos diferentes
+  hist_t hist;  // Durações (ns)
+} offcpu_site_t;
+
+int offcpu_enabled = 0;
+
+static offcpu_site_t *sites = NULL; // Tabela de dispersão, endereçamento aberto
+static unsigned long lost = 0;      // Bloqueios descartados (tabela cheia)
+static const char *offcpu_path = NULL;
+
+static const char *reason_names[OFFCPU_REASONS] = {
+    "suspend", "wait", "sleep", "period", "sem", "mutex", "barrier", "mqueue"};
+
+// Registra um bloqueio na entrada do seu local e motivo
+void offcpu_record(int reason, void *object, void *site, unsigned long long ns)
+{
+  unsigned int i, n;
+  offcpu_site_t *entry;
+
+  if (!offcpu_enabled)
+    return;
+
+  i = (((uintptr_t)site >> 2) * 31 + reason) % OFFCPU_SITES;
+  for (n = 0; n < OFFCPU_SITES; n++, i = (i + 1) % OFFCPU_SITES)
+  {
+    entry = &sites[i];
+    if (entry->site == NULL)
+    {
+      entry->site = site;
+      entry->reason = reason;
+      entry->object = object;
+      break;
+    }
+    if (entry->site == site && entry->reason == reason)
+      break;
+  }
+  if (n == OFFCPU_SITES)
+  {
+    lost++;
+    return;
+  }
+
+  if (entry->object != object)
+    entry->mixed = 1;
+  hist_add(&entry->hist, ns);
+}
+
+// Ordena os locais pelo tempo total bloqueado, decrescente
+static int total_cmp(const void *a, const void *b)
+{
+  unsigned long long x = ((const offcpu_site_t *)a)->hist.sum;
+  unsigned long long y = ((const offcpu_site_t *)b)->hist.sum;
+
+  return (x < y) - (x > y);
+}
+
+// Salva o relatório: um local por linha, do que mais bloqueou ao que menos
+static void offcpu_atexit()
+{
+  offcpu_site_t *entry;
+  Dl_info info;
+  FILE *file;
+  int i;
+
+  offcpu_enabled = 0;
+  if ((file = fopen(offcpu_path, "w")) == NULL)
+  {
+    perror("ppos: offcpu");
+    return;
+  }
+
+  qsort(sites, OFFCPU_SITES, sizeof(offcpu_site_t), total_cmp);
+
+  fprintf(file, "# bloqueios por local de chamada, em ordem de tempo total (%lu descartados)\n", lost);
+  fprintf(file, "# %10s %8s %10s %10s %10s %10s %-8s %-18s %s\n", "total ms", "count", "avg us",
+          "p50 us", "p99 us", "max us", "reason", "object", "site");
+  for (i = 0; i < OFFCPU_SITES && sites[i].site != NULL; i++)
+  {
+    entry = &sites[i];
+    fprintf(file, "  %10.3f %8llu %10llu %10llu %10llu %10llu %-8s ", entry->hist.sum / 1e6,
+            entry->hist.count, entry->hist.sum / entry->hist.count / 1000,
+            hist_percentile(&entry->hist, 50) / 1000, hist_percentile(&entry->hist, 99) / 1000,
+            entry->hist.max / 1000, reason_names[entry->reason]);
+    if (entry->mixed)
+      fprintf(file, "%-18s ", "(varios)");
+    else
+      fprintf(file, "%-18p ", entry->object);
+
+    // Local: função (se exportada) e módulo+deslocamento, para addr2line
+    if (dladdr(entry->site, &info) && info.dli_fbase != NULL)
+    {
+      if (info.dli_sname != NULL)
+        fprintf(file, "%s+0x%lx ", info.dli_sname,
+                (unsigned long)((uintptr_t)entry->site - (uintptr_t)info.dli_saddr));
+      fprintf(file, "(%s+0x%lx)\n", info.dli_fname,
+              (unsigned long)((uintptr_t)entry->site - (uintptr_t)info.dli_fbase));
+    }
+    else
+      fprintf(file, "%p\n", entry->site);
+  }
+  fclose(file);
+}
+
+// Liga o registro
+void offcpu_init(const char *path)
+{
+  if (path == NULL || *path == '\0')
+    return;
+
+  sites = calloc(OFFCPU_SITES, sizeof(offcpu_site_t));
+  if (sites == NULL)
+  {
+    perror("ppos: offcpu");
+    return;
+  }
+
+  offcpu_path = path;
+  atexit(offcpu_atexit);
+  offcpu_enabled = 1;
+}
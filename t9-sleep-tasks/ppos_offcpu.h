@@ -0,0 +1,36 @@
+// PingPongOS - PingPong Operating System
+
+// Análise fora da CPU: cada bloqueio de uma tarefa (suspensão, espera por
+// outra tarefa, sono, ...) é registrado com o motivo, o objeto esperado, o
+// local da chamada que bloqueou e a duração. Os registros são agregados por
+// local de chamada e motivo, em totais e histogramas, e salvos em texto ao
+// fim do processo. Módulo separado porque a identificação dos locais usa
+// dladdr(), que exige _GNU_SOURCE.
+
+#ifndef __PPOS_OFFCPU__
+#define __PPOS_OFFCPU__
+
+#define OFFCPU_SITES 256 // Pares (local, motivo) distintos; os demais são descartados
+
+// Motivos de bloqueio
+#define OFFCPU_SUSPEND 0 // task_suspend e task_suspend_timeout
+#define OFFCPU_WAIT 1    // task_wait e task_wait_timeout
+#define OFFCPU_SLEEP 2   // task_sleep e variantes
+#define OFFCPU_PERIOD 3  // task_wait_period
+#define OFFCPU_SEM 4     // semáforos
+#define OFFCPU_MUTEX 5   // mutexes
+#define OFFCPU_BARRIER 6 // barreiras
+#define OFFCPU_MQUEUE 7  // filas de mensagens
+#define OFFCPU_REASONS 8
+
+// Registro ligado (ver offcpu_init)
+extern int offcpu_enabled;
+
+// Liga o registro, salvando o relatório em "path" ao fim do processo
+// (path NULL ou vazio: desligado)
+void offcpu_init(const char *path);
+
+// Registra um bloqueio de "ns" nanossegundos
+void offcpu_record(int reason, void *object, void *site, unsigned long long ns);
+
+#endif
@@ -0,0 +1,111 @@
+// PingPongOS - PingPong Operating System
+
+// Contadores de desempenho por tarefa (ver ppos_perf.h)
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "ppos_perf.h"
+
+// Contador de hardware e seu substituto de software (type < 0: nenhum)
+typedef struct
+{
+  const char *name;
+  int type;
+  unsigned long long config;
+  const char *fallback_name;
+  int fallback_type;
+  unsigned long long fallback_config;
+} perf_event_t;
+
+static const perf_event_t events[PERF_COUNTERS] = {
+    [PERF_INSTRUCTIONS] = {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, NULL, -1, 0},
+    [PERF_CYCLES] = {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,
+                     "task-clock ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    [PERF_CACHE_MISSES] = {"cache misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, NULL, -1, 0},
+    [PERF_PAGE_FAULTS] = {"page faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, NULL, -1, 0},
+};
+
+int perf_enabled = 0;
+
+static int leader = -1;                             // Descritor do líder do grupo
+static int slot[PERF_COUNTERS];                     // Contador -> posição no grupo (-1: fechado)
+static const char *names[PERF_COUNTERS];            // Nome do evento aberto
+static unsigned long long last[PERF_COUNTERS];      // Leitura anterior, por posição no grupo
+
+// Abre um evento do processo, só em modo usuário, no grupo do líder
+static int perf_open(int type, unsigned long long config)
+{
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+
+  return syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+}
+
+// Abre os contadores disponíveis, todos num grupo lido de uma só vez
+int perf_init()
+{
+  int i, fd;
+
+  for (i = 0; i < PERF_COUNTERS; i++)
+  {
+    slot[i] = -1;
+    names[i] = events[i].name;
+    fd = perf_open(events[i].type, events[i].config);
+    if (fd < 0 && events[i].fallback_type >= 0)
+    {
+      names[i] = events[i].fallback_name;
+      fd = perf_open(events[i].fallback_type, events[i].fallback_config);
+    }
+    if (fd < 0)
+      continue;
+
+    if (leader < 0)
+      leader = fd;
+    slot[i] = perf_enabled++;
+  }
+
+  if (perf_enabled == 0)
+    fprintf(stderr, "ppos: contadores de desempenho indisponíveis\n");
+  else
+    perf_account(NULL);
+
+  return perf_enabled;
+}
+
+// Lê o grupo e soma as diferenças desde a leitura anterior
+void perf_account(unsigned long long *values)
+{
+  unsigned long long data[1 + PERF_COUNTERS];
+  int i;
+
+  if (!perf_enabled || read(leader, data, sizeof(data)) < (ssize_t)(sizeof(data[0]) * (1 + perf_enabled)))
+    return;
+
+  for (i = 0; i < PERF_COUNTERS; i++)
+  {
+    if (slot[i] < 0)
+      continue;
+    if (values != NULL)
+      values[i] += data[1 + slot[i]] - last[slot[i]];
+    last[slot[i]] = data[1 + slot[i]];
+  }
+}
+
+// Nome do contador, ou NULL se ele não foi aberto
+const char *perf_name(int counter)
+{
+  if (counter < 0 || counter >= PERF_COUNTERS || !perf_enabled || slot[counter] < 0)
+    return NULL;
+  return names[counter];
+}
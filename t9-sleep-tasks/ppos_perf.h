@@ -0,0 +1,35 @@
+// PingPongOS - PingPong Operating System
+
+// Contadores de desempenho por tarefa: o núcleo abre contadores do processo
+// hospedeiro com perf_event_open (instruções, ciclos, faltas de cache e de
+// página) e, a cada troca de contexto, cobra da tarefa que sai a diferença
+// desde a leitura anterior. Sem acesso aos contadores de hardware (máquina
+// virtual, perf_event_paranoid), os ciclos são substituídos pelo contador de
+// software task-clock e os demais de hardware ficam indisponíveis. Módulo
+// separado porque a chamada de sistema exige _GNU_SOURCE.
+
+#ifndef __PPOS_PERF__
+#define __PPOS_PERF__
+
+// Contadores (índices dos vetores de valores)
+#define PERF_INSTRUCTIONS 0 // Instruções executadas
+#define PERF_CYCLES 1       // Ciclos (ou task-clock, em ns, sem hardware)
+#define PERF_CACHE_MISSES 2 // Faltas na cache de último nível
+#define PERF_PAGE_FAULTS 3  // Faltas de página (software)
+#define PERF_COUNTERS 4
+
+// Contadores abertos (ver perf_init)
+extern int perf_enabled;
+
+// Abre os contadores disponíveis; retorna quantos foram abertos (0: nenhum,
+// e perf_account não faz nada)
+int perf_init();
+
+// Soma em "values" (PERF_COUNTERS posições; NULL: descarta) o que os
+// contadores acumularam desde a chamada anterior
+void perf_account(unsigned long long *values);
+
+// Nome do contador, ou NULL se ele não foi aberto
+const char *perf_name(int counter);
+
+#endif
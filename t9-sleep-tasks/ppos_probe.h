@@ -0,0 +1,50 @@
+// PingPongOS - PingPong Operating System
+
+// Pontos de rastreamento estáticos (USDT) nos eventos do escalonador. Com
+// <sys/sdt.h> (pacote systemtap-sdt-dev) disponível, cada PROBEn() gera só
+// uma instrução nop e uma nota ELF; bpftrace e perf a transformam em ponto
+// de parada quando se conectam ao processo, sem recompilar:
+//
+//   bpftrace -l 'usdt:./ppos:ppos:*'
+//   bpftrace -e 'usdt:./ppos:ppos:task__switch { @[arg1] = count(); }' -p PID
+//
+// Sem o cabeçalho (ou com -DPPOS_NO_USDT) os pontos somem do código.
+//
+// Pontos (provedor "ppos") e argumentos:
+//   task__create   tarefa, prioridade, tarefas prontas
+//   task__switch   tarefa que sai, tarefa que entra, prioridade da que
+//                  entra, tarefas prontas
+//   task__yield    tarefa, prioridade, tarefas prontas
+//   task__suspend  tarefa, fila (endereço), tarefas prontas
+//   task__awake    tarefa acordada, tarefa que acordou, tarefas prontas
+//   task__sleep    tarefa, instante de acordar (ns), tarefas adormecidas
+//   task__throttle tarefa, instante de liberação (ns), tarefas adormecidas
+//   task__wake     tarefa, atraso do despertar (ns), tarefas adormecidas
+//   task__exit     tarefa, código de saída, tempo em execução (ns)
+//   tick           tarefa atual, ticks desde a inicialização, tarefas prontas
+
+#ifndef __PPOS_PROBE__
+#define __PPOS_PROBE__
+
+#if defined(__has_include) && !defined(PPOS_NO_USDT)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define PPOS_USDT 1
+#endif
+#endif
+
+#ifdef PPOS_USDT
+#define PROBE3(name, a, b, c) DTRACE_PROBE3(ppos, name, a, b, c)
+#define PROBE4(name, a, b, c, d) DTRACE_PROBE4(ppos, name, a, b, c, d)
+#else
+#define PROBE3(name, a, b, c) \
+  do                          \
+  {                           \
+  } while (0)
+#define PROBE4(name, a, b, c, d) \
+  do                             \
+  {                              \
+  } while (0)
+#endif
+
+#endif
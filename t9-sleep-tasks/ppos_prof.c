@@ -0,0 +1,185 @@
+// PingPongOS - PingPong Operating System
+
+// Perfil de CPU por amostragem (ver ppos_prof.h)
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <ucontext.h>
+#include "ppos_prof.h"
+
+#define PROF_MODULES 32 // Módulos distintos no arquivo de amostras
+
+// Uma amostra: tarefa e pilha de chamadas, do ponto interrompido para fora
+typedef struct
+{
+  int task;
+  int depth;
+  uintptr_t pc[PROF_DEPTH];
+} prof_sample_t;
+
+volatile int prof_enabled = 0;
+
+static prof_sample_t *samples = NULL;   // Amostras registradas
+static int sample_count = 0;
+static unsigned long lost = 0;          // Amostras descartadas (buffer cheio)
+static int period = 1;                  // Ticks entre amostras
+static int countdown = 1;               // Ticks até a próxima amostra
+static uintptr_t main_top = 0;          // Limite superior da pilha da main
+static const char *prof_path = NULL;
+
+// Registra uma amostra do contexto interrompido
+void prof_sample(void *context, int task, void *stack, unsigned long size)
+{
+#if defined(__x86_64__)
+  ucontext_t *uc = context;
+  uintptr_t fp, sp, lo, hi, next;
+  prof_sample_t *s;
+
+  if (--countdown > 0)
+    return;
+  countdown = period;
+
+  if (sample_count >= PROF_SAMPLES)
+  {
+    lost++;
+    return;
+  }
+
+  s = &samples[sample_count++];
+  s->task = task;
+  s->pc[0] = uc->uc_mcontext.gregs[REG_RIP];
+  s->depth = 1;
+
+  // Percorre a cadeia de ponteiros de quadro só enquanto ela fica dentro da
+  // pilha da tarefa (rbp pode não ser um ponteiro de quadro em código
+  // compilado sem eles)
+  fp = uc->uc_mcontext.gregs[REG_RBP];
+  sp = uc->uc_mcontext.gregs[REG_RSP];
+  lo = stack ? (uintptr_t)stack : sp;
+  hi = stack ? (uintptr_t)stack + size : main_top;
+  while (s->depth < PROF_DEPTH && fp >= lo && fp >= sp && fp + 16 <= hi && (fp & 7) == 0)
+  {
+    next = ((uintptr_t *)fp)[0];
+    if (((uintptr_t *)fp)[1] == 0)
+      break;
+    s->pc[s->depth++] = ((uintptr_t *)fp)[1];
+    if (next <= fp)
+      break;
+    fp = next;
+  }
+#else
+  // Sem acesso portável ao contexto interrompido: nada a amostrar
+  lost++;
+#endif
+}
+
+// Endereço a simbolizar do quadro j: endereços de retorno apontam para a
+// instrução seguinte à chamada
+static uintptr_t frame_addr(prof_sample_t *sample, int j)
+{
+  return sample->pc[j] - (j > 0);
+}
+
+// Salva as amostras: cada endereço é escrito como módulo e deslocamento, já
+// que executáveis PIE e bibliotecas são carregados em endereços variáveis
+static void prof_atexit()
+{
+  uintptr_t bases[PROF_MODULES], self_base;
+  char exe[4096];
+  Dl_info info;
+  int nmodules = 0, i, j, m;
+  ssize_t len;
+  FILE *file;
+
+  prof_enabled = 0;
+  if ((file = fopen(prof_path, "w")) == NULL)
+  {
+    perror("ppos: profile");
+    return;
+  }
+
+  // dladdr() informa o executável pelo nome usado para executá-lo
+  len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  exe[len > 0 ? len : 0] = '\0';
+  dladdr((void *)prof_atexit, &info);
+  self_base = (uintptr_t)info.dli_fbase;
+
+  fprintf(file, "ppos-profile 1\n");
+  fprintf(file, "period %d samples %d lost %lu\n", period, sample_count, lost);
+
+  // Módulos que contêm os endereços amostrados
+  for (i = 0; i < sample_count; i++)
+    for (j = 0; j < samples[i].depth; j++)
+    {
+      if (!dladdr((void *)frame_addr(&samples[i], j), &info) || info.dli_fbase == NULL)
+        continue;
+      for (m = 0; m < nmodules && bases[m] != (uintptr_t)info.dli_fbase; m++)
+        ;
+      if (m == nmodules && nmodules < PROF_MODULES)
+      {
+        bases[nmodules++] = (uintptr_t)info.dli_fbase;
+        fprintf(file, "module %d %s\n", m,
+                (uintptr_t)info.dli_fbase == self_base ? exe : info.dli_fname);
+      }
+    }
+
+  // Amostras: tarefa e quadros como módulo:deslocamento ("?": desconhecido)
+  for (i = 0; i < sample_count; i++)
+  {
+    fprintf(file, "sample %d", samples[i].task);
+    for (j = 0; j < samples[i].depth; j++)
+    {
+      if (dladdr((void *)frame_addr(&samples[i], j), &info) && info.dli_fbase != NULL)
+        for (m = 0; m < nmodules && bases[m] != (uintptr_t)info.dli_fbase; m++)
+          ;
+      else
+        m = nmodules;
+      if (m < nmodules)
+        fprintf(file, " %d:%lx", m, (unsigned long)(frame_addr(&samples[i], j) - bases[m]));
+      else
+        fprintf(file, " ?");
+    }
+    fprintf(file, "\n");
+  }
+  fclose(file);
+}
+
+// Liga a amostragem
+void prof_init(const char *path, int sample_period)
+{
+  pthread_attr_t attr;
+  void *stack;
+  size_t size;
+
+  if (path == NULL || *path == '\0')
+    return;
+
+  // Topo da pilha da main: a da thread inicial do processo, que contém os
+  // quadros de quem chamou o núcleo
+  if (pthread_getattr_np(pthread_self(), &attr) != 0 ||
+      pthread_attr_getstack(&attr, &stack, &size) != 0)
+  {
+    perror("ppos: profile");
+    return;
+  }
+  pthread_attr_destroy(&attr);
+
+  samples = malloc(PROF_SAMPLES * sizeof(prof_sample_t));
+  if (samples == NULL)
+  {
+    perror("ppos: profile");
+    return;
+  }
+
+  prof_path = path;
+  period = countdown = (sample_period > 0) ? sample_period : 1;
+  main_top = (uintptr_t)stack + size;
+  atexit(prof_atexit);
+  prof_enabled = 1;
+}
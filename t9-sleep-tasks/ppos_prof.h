@@ -0,0 +1,30 @@
+// PingPongOS - PingPong Operating System
+
+// Perfil de CPU por amostragem: o tratador de ticks registra a tarefa atual
+// e a pilha de chamadas interrompida (percorrida pelos ponteiros de quadro).
+// Ao fim do processo as amostras são salvas em texto, com os endereços
+// relativos ao módulo (executável ou biblioteca) que os contém; a ferramenta
+// ppos-prof os simboliza e produz pilhas "folded" por tarefa, para gráficos
+// de chama. Módulo separado porque precisa de _GNU_SOURCE, que ppos.h não
+// permite.
+
+#ifndef __PPOS_PROF__
+#define __PPOS_PROF__
+
+#define PROF_DEPTH 8        // Quadros guardados por amostra
+#define PROF_SAMPLES 32768  // Amostras guardadas (as seguintes são descartadas)
+
+// Amostragem ligada (ver prof_init)
+extern volatile int prof_enabled;
+
+// Liga a amostragem a cada "period" ticks, salvando as amostras em "path" ao
+// fim do processo (path NULL ou vazio: desligada). Chamada pela thread
+// inicial, cuja pilha é a da main.
+void prof_init(const char *path, int period);
+
+// Registra uma amostra da tarefa "task", interrompida no contexto "context"
+// (o terceiro argumento de um tratador SA_SIGINFO); "stack" e "size" são a
+// pilha da tarefa (NULL para a main). Chamada pelo tratador de ticks.
+void prof_sample(void *context, int task, void *stack, unsigned long size);
+
+#endif
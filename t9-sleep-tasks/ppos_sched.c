@@ -0,0 +1,849 @@
+// PingPongOS - PingPong Operating System
+
+// Políticas de escalonamento do núcleo
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+#include "ppos_sched.h"
+#include "queue.h"
+
+int sched_quantum = QUANTUM;
+int sched_aging = ALPHA;
+int mlfq_levels = MLFQ_LEVELS;
+int mlfq_boost = MLFQ_BOOST;
+sched_policy_t *sched_normal = &sched_prio;
+int sched_repick = 0;
+
+// Fatia de tempo comum às políticas que contam ticks -------------------------
+
+// Consome um tick da fatia da tarefa; preempta quando a fatia se esgota
+static int slice_tick(task_t *task)
+{
+  return (--task->slice <= 0) ? SCHED_PREEMPT : SCHED_CONTINUE;
+}
+
+// Não há preempção por tempo
+static int no_tick(task_t *task)
+{
+  return SCHED_CONTINUE;
+}
+
+// Nada a fazer
+static void no_op(task_t *task)
+{
+}
+
+// Classe de tempo real por prazo (EDF) --------------------------------------
+
+#define DL_MAX_UTIL 950000 // Utilização máxima da classe (em milionésimos de CPU)
+
+static rb_tree_t dl_tree;      // Tarefas prontas, ordenadas por prazo absoluto
+static long dl_total_util = 0; // Utilização reservada (em milionésimos de CPU)
+
+// Utilização reservada por uma tarefa (em milionésimos de CPU)
+static long dl_util(int period, int runtime)
+{
+  return (long)runtime * 1000000 / period;
+}
+
+static int dl_less(const rb_node_t *a, const rb_node_t *b)
+{
+  return rb_entry(a, task_t, rb_node)->dl_abs_deadline <
+         rb_entry(b, task_t, rb_node)->dl_abs_deadline;
+}
+
+// Inicia um novo período: o job recebe prazo e orçamento completos
+static void dl_replenish(task_t *task, unsigned long long now)
+{
+  task->dl_release = now;
+  task->dl_abs_deadline = now + task->dl_deadline * NS_PER_MS;
+  task->dl_budget = task->dl_runtime * 1000 / TICK_INTERVAL;
+  task->dl_missed = 0;
+}
+
+// Conta o prazo perdido uma única vez por job
+static void dl_miss(task_t *task)
+{
+  if (!task->dl_missed)
+  {
+    task->dl_missed = 1;
+    task->deadline_misses++;
+  }
+}
+
+int sched_dl_admit(task_t *task, int period, int runtime, int deadline)
+{
+  long util = dl_util(period, runtime);
+  long old = (task->sched_class == SCHED_CLASS_DEADLINE)
+                 ? dl_util(task->dl_period, task->dl_runtime)
+                 : 0;
+
+  if (dl_total_util - old + util > DL_MAX_UTIL)
+    return -1;
+
+  dl_total_util += util - old;
+  task->dl_period = period;
+  task->dl_runtime = runtime;
+  task->dl_deadline = deadline;
+  task->dl_throttled = 0;
+  dl_replenish(task, systime_ns());
+
+  return 0;
+}
+
+void sched_dl_release(task_t *task)
+{
+  dl_total_util -= dl_util(task->dl_period, task->dl_runtime);
+}
+
+static void dl_enqueue(task_t *task)
+{
+  rb_insert(&dl_tree, &task->rb_node, dl_less);
+}
+
+static void dl_dequeue(task_t *task)
+{
+  rb_remove(&dl_tree, &task->rb_node);
+
+  // O job ainda não terminou e o prazo já passou
+  if (systime_ns() > task->dl_abs_deadline)
+    dl_miss(task);
+}
+
+// Escolhe a tarefa de prazo absoluto mais próximo
+static task_t *dl_pick_next()
+{
+  rb_node_t *first = rb_first(&dl_tree);
+
+  return first ? rb_entry(first, task_t, rb_node) : NULL;
+}
+
+// Consome o orçamento: esgotado, a tarefa fica bloqueada até o próximo
+// período; também cede a CPU se chegou uma tarefa de prazo mais próximo
+static int dl_tick(task_t *task)
+{
+  unsigned long long now = systime_ns();
+  task_t *first;
+
+  if (now > task->dl_abs_deadline)
+    dl_miss(task);
+
+  if (--task->dl_budget <= 0)
+  {
+    unsigned long long release = task->dl_release + task->dl_period * NS_PER_MS;
+
+    while (release <= now)
+      release += task->dl_period * NS_PER_MS;
+    task->wake_time = release;
+    task->dl_throttled = 1;
+    task->dl_throttles++;
+    return SCHED_THROTTLE;
+  }
+
+  first = dl_pick_next();
+  if (first != NULL && first->dl_abs_deadline < task->dl_abs_deadline)
+    return SCHED_PREEMPT;
+
+  return SCHED_CONTINUE;
+}
+
+// Ao acordar num novo período (ou após o prazo do job atual) a tarefa
+// recebe novo prazo e orçamento. Esgotar o orçamento é a reserva sendo
+// cumprida, não prazo perdido: só é contado à parte
+static void dl_on_wake(task_t *task)
+{
+  unsigned long long now = systime_ns(), period = task->dl_period * NS_PER_MS;
+  unsigned long long release;
+
+  task->dl_throttled = 0;
+
+  if (now >= task->dl_release + period || now >= task->dl_abs_deadline)
+  {
+    // O novo período começa na grade dos anteriores, para que o atraso do
+    // despertar não se acumule, desde que o prazo dele ainda não tenha passado
+    release = now - (now - task->dl_release) % period;
+    if (release + task->dl_deadline * NS_PER_MS <= now)
+      release = now;
+    dl_replenish(task, release);
+  }
+}
+
+sched_policy_t sched_dl = {
+    .name = "edf",
+    .enqueue = dl_enqueue,
+    .dequeue = dl_dequeue,
+    .pick_next = dl_pick_next,
+    .tick = dl_tick,
+    .on_wake = dl_on_wake,
+    .on_yield = no_op,
+};
+
+// Classe de tempo real (FIFO/RR) --------------------------------------------
+
+static queue_t *rt_queue = NULL; // Fila de tarefas prontas de tempo real
+
+static void rt_enqueue(task_t *task)
+{
+  queue_append(&rt_queue, (queue_t *)task);
+}
+
+static void rt_dequeue(task_t *task)
+{
+  queue_remove(&rt_queue, (queue_t *)task);
+
+  // RR usa o quantum da própria tarefa a cada ativação
+  task->slice = task->quantum;
+}
+
+// Seleciona a tarefa FIFO/RR de maior prioridade estática; entre prioridades
+// iguais vale a ordem de chegada na fila
+static task_t *rt_pick_next()
+{
+  if (rt_queue == NULL)
+    return NULL;
+
+  task_t *highest_prio_task = (task_t *)rt_queue;
+  task_t *current = highest_prio_task->next;
+
+  // Não há envelhecimento: a tarefa escolhida é sempre a de maior prioridade
+  while (current != (task_t *)rt_queue)
+  {
+    if (current->static_prio < highest_prio_task->static_prio)
+      highest_prio_task = current;
+    current = current->next;
+  }
+
+  return highest_prio_task;
+}
+
+// Tarefas FIFO não sofrem preempção por tempo
+static int rt_tick(task_t *task)
+{
+  if (task->sched_class == SCHED_CLASS_FIFO)
+    return SCHED_CONTINUE;
+
+  return slice_tick(task);
+}
+
+sched_policy_t sched_rt = {
+    .name = "rt",
+    .enqueue = rt_enqueue,
+    .dequeue = rt_dequeue,
+    .pick_next = rt_pick_next,
+    .tick = rt_tick,
+    .on_wake = no_op,
+    .on_yield = no_op,
+};
+
+// Prioridade com envelhecimento ---------------------------------------------
+
+static queue_t *prio_queue = NULL; // Fila de tarefas prontas
+
+static void prio_enqueue(task_t *task)
+{
+  queue_append(&prio_queue, (queue_t *)task);
+}
+
+static void prio_dequeue(task_t *task)
+{
+  queue_remove(&prio_queue, (queue_t *)task);
+  task->slice = sched_quantum;
+}
+
+// Seleciona a tarefa de maior prioridade (menor valor) da fila
+static task_t *prio_pick_next()
+{
+  if (prio_queue == NULL)
+    return NULL;
+
+  // Localiza a tarefa com maior prioridade (menor valor numérico)
+  task_t *highest_prio_task = NULL;
+  task_t *current = (task_t *)prio_queue;
+  task_t *first = current;
+  int highest_prio = MAX_PRIO + 1; // Inicializa com um valor maior que qualquer prioridade possível
+
+  // Percorre a fila em busca da tarefa com maior prioridade (menor valor numérico)
+  do
+  {
+    // Se a prioridade dinâmica desta tarefa for maior (valor menor)
+    if (current->dynamic_prio < highest_prio)
+    {
+      highest_prio = current->dynamic_prio;
+      highest_prio_task = current;
+    }
+    current = current->next;
+  } while (current != first);
+
+  // Envelhece todas as tarefas que não foram escolhidas (uma vez por decisão)
+  current = first;
+  do
+  {
+    if (current != highest_prio_task && !sched_repick)
+    {
+      // Aplica o envelhecimento (aumenta a prioridade - diminui o valor)
+      current->dynamic_prio += sched_aging;
+
+      // Garante que não ultrapasse a prioridade máxima
+      if (current->dynamic_prio < MIN_PRIO)
+        current->dynamic_prio = MIN_PRIO;
+    }
+    current = current->next;
+  } while (current != first);
+
+  // Reseta a prioridade dinâmica da tarefa escolhida para seu valor estático
+  highest_prio_task->dynamic_prio = highest_prio_task->static_prio;
+
+  return highest_prio_task;
+}
+
+sched_policy_t sched_prio = {
+    .name = "prio",
+    .enqueue = prio_enqueue,
+    .dequeue = prio_dequeue,
+    .pick_next = prio_pick_next,
+    .tick = slice_tick,
+    .on_wake = no_op,
+    .on_yield = no_op,
+};
+
+// FCFS e round-robin: fila única, sempre executa a primeira tarefa -----------
+
+static queue_t *fifo_queue = NULL; // Fila de tarefas prontas (FCFS e RR)
+
+static void fifo_enqueue(task_t *task)
+{
+  queue_append(&fifo_queue, (queue_t *)task);
+}
+
+static void fifo_dequeue(task_t *task)
+{
+  queue_remove(&fifo_queue, (queue_t *)task);
+  task->slice = sched_quantum;
+}
+
+static task_t *fifo_pick_next()
+{
+  return (task_t *)fifo_queue;
+}
+
+sched_policy_t sched_fcfs = {
+    .name = "fcfs",
+    .enqueue = fifo_enqueue,
+    .dequeue = fifo_dequeue,
+    .pick_next = fifo_pick_next,
+    .tick = no_tick,
+    .on_wake = no_op,
+    .on_yield = no_op,
+};
+
+sched_policy_t sched_rr = {
+    .name = "rr",
+    .enqueue = fifo_enqueue,
+    .dequeue = fifo_dequeue,
+    .pick_next = fifo_pick_next,
+    .tick = slice_tick,
+    .on_wake = no_op,
+    .on_yield = no_op,
+};
+
+// Justiça proporcional (CFS) ------------------------------------------------
+
+#define NICE_0_WEIGHT 1024 // Peso de uma tarefa de prioridade 0
+
+// Peso de cada prioridade estática, de -20 a +19 (+20 é tratada como +19);
+// cada nível muda em cerca de 10% a fatia de CPU, como a tabela do Linux
+static const int prio_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+    9548, 7620, 6100, 4904, 3906,
+    3121, 2501, 1991, 1586, 1277,
+    1024, 820, 655, 526, 423,
+    335, 272, 215, 172, 137,
+    110, 87, 70, 56, 45,
+    36, 29, 23, 18, 15,
+};
+
+static rb_tree_t cfs_tree;                  // Tarefas prontas, ordenadas por vruntime
+static int cfs_count = 0;                   // Número de tarefas na árvore
+static unsigned long cfs_total_weight = 0;  // Soma dos pesos das tarefas na árvore
+static unsigned long long min_vruntime = 0; // Menor vruntime vista (nunca recua)
+
+static int cfs_weight(task_t *task)
+{
+  int prio = task->static_prio;
+
+  if (prio < MIN_PRIO)
+    prio = MIN_PRIO;
+  else if (prio > MAX_PRIO - 1)
+    prio = MAX_PRIO - 1;
+
+  return prio_to_weight[prio - MIN_PRIO];
+}
+
+static int cfs_less(const rb_node_t *a, const rb_node_t *b)
+{
+  return rb_entry(a, task_t, rb_node)->vruntime < rb_entry(b, task_t, rb_node)->vruntime;
+}
+
+// Avança min_vruntime até a menor vruntime entre a tarefa indicada e a árvore
+static void cfs_update_min(task_t *task)
+{
+  unsigned long long vruntime = task->vruntime;
+  rb_node_t *first = rb_first(&cfs_tree);
+
+  if (first != NULL && rb_entry(first, task_t, rb_node)->vruntime < vruntime)
+    vruntime = rb_entry(first, task_t, rb_node)->vruntime;
+
+  if (vruntime > min_vruntime)
+    min_vruntime = vruntime;
+}
+
+static void cfs_enqueue(task_t *task)
+{
+  task->weight = cfs_weight(task);
+  rb_insert(&cfs_tree, &task->rb_node, cfs_less);
+  cfs_count++;
+  cfs_total_weight += task->weight;
+}
+
+// Ao sair da árvore a tarefa recebe a fatia ideal: numa "rodada" de
+// sched_quantum ticks por tarefa pronta, a parte proporcional ao seu peso
+static void cfs_dequeue(task_t *task)
+{
+  rb_remove(&cfs_tree, &task->rb_node);
+  task->slice = (int)((unsigned long long)sched_quantum * cfs_count * task->weight /
+                      cfs_total_weight);
+  if (task->slice < 1)
+    task->slice = 1;
+  cfs_count--;
+  cfs_total_weight -= task->weight;
+
+  cfs_update_min(task);
+}
+
+// Escolhe a tarefa de menor vruntime, em O(1) graças ao cache da árvore
+static task_t *cfs_pick_next()
+{
+  rb_node_t *first = rb_first(&cfs_tree);
+
+  return first ? rb_entry(first, task_t, rb_node) : NULL;
+}
+
+// Cobra o tick da tarefa em tempo virtual: quanto maior o peso, mais devagar
+// sua vruntime avança
+static int cfs_tick(task_t *task)
+{
+  task->vruntime += TICK_NS * NICE_0_WEIGHT / cfs_weight(task);
+  cfs_update_min(task);
+
+  if (--task->slice > 0)
+    return SCHED_CONTINUE;
+
+  // Fatia esgotada: só cede a CPU se houver outra tarefa pronta
+  if (cfs_count > 0)
+    return SCHED_PREEMPT;
+
+  task->slice = sched_quantum;
+  return SCHED_CONTINUE;
+}
+
+// Posiciona a tarefa em relação a min_vruntime: tarefas novas entram em
+// min_vruntime; tarefas que dormiram recebem no máximo meia rodada de crédito,
+// para não monopolizar a CPU com a vruntime antiga
+static void cfs_on_wake(task_t *task)
+{
+  unsigned long long credit = sched_quantum * TICK_NS / 2;
+  unsigned long long floor;
+
+  if (task->activations == 0)
+  {
+    task->vruntime = min_vruntime;
+    return;
+  }
+
+  floor = (min_vruntime > credit) ? min_vruntime - credit : 0;
+  if (task->vruntime < floor)
+    task->vruntime = floor;
+}
+
+sched_policy_t sched_cfs = {
+    .name = "cfs",
+    .enqueue = cfs_enqueue,
+    .dequeue = cfs_dequeue,
+    .pick_next = cfs_pick_next,
+    .tick = cfs_tick,
+    .on_wake = cfs_on_wake,
+    .on_yield = no_op,
+};
+
+// Filas multinível com realimentação (MLFQ) ---------------------------------
+//
+// Cada nível tem sua fila e seu quantum, que dobra a cada nível. O quantum é
+// o tempo total que a tarefa pode usar no nível, mesmo que bloqueie no meio:
+// quem o esgota desce um nível; quem bloqueia antes continua no mesmo nível.
+// A cada mlfq_boost ticks todas as tarefas voltam ao nível 0 (sem inanição).
+
+static queue_t *mlfq_queue[MLFQ_MAX_LEVELS]; // Fila de prontas de cada nível
+static int mlfq_ready[MLFQ_MAX_LEVELS];      // Tarefas prontas em cada nível
+static unsigned int mlfq_epoch = 0;          // Número de elevações já feitas
+static int mlfq_boost_ticks = 0;             // Ticks desde a última elevação
+
+// Estatísticas de residência por nível
+static unsigned long mlfq_ticks[MLFQ_MAX_LEVELS];
+static unsigned long mlfq_dispatches[MLFQ_MAX_LEVELS];
+static unsigned long mlfq_demotions[MLFQ_MAX_LEVELS];
+
+// Quantum do nível: um quarto do quantum padrão no nível 0, dobrando a cada nível
+static int mlfq_quantum(int level)
+{
+  int quantum = sched_quantum / 4;
+
+  return (quantum < 1 ? 1 : quantum) << level;
+}
+
+// Coloca a tarefa no nível indicado, com o quantum completo do nível
+static void mlfq_set_level(task_t *task, int level)
+{
+  task->mlfq_level = level;
+  task->slice = mlfq_quantum(level);
+  task->mlfq_epoch = mlfq_epoch;
+}
+
+static void mlfq_enqueue(task_t *task)
+{
+  // Tarefas que não viram a última elevação (bloqueadas) voltam ao nível 0
+  if (task->mlfq_epoch != mlfq_epoch)
+    mlfq_set_level(task, 0);
+
+  // Tarefas novas (ou vindas de outra política) podem ter fatia maior
+  if (task->mlfq_level >= mlfq_levels)
+    mlfq_set_level(task, mlfq_levels - 1);
+  if (task->slice > mlfq_quantum(task->mlfq_level))
+    task->slice = mlfq_quantum(task->mlfq_level);
+
+  queue_append(&mlfq_queue[task->mlfq_level], (queue_t *)task);
+  mlfq_ready[task->mlfq_level]++;
+}
+
+// A fatia não é renovada ao sair da fila: ela só se renova ao mudar de nível
+static void mlfq_dequeue(task_t *task)
+{
+  queue_remove(&mlfq_queue[task->mlfq_level], (queue_t *)task);
+  mlfq_ready[task->mlfq_level]--;
+  mlfq_dispatches[task->mlfq_level]++;
+}
+
+// Primeira tarefa do nível não vazio de maior prioridade
+static task_t *mlfq_pick_next()
+{
+  for (int level = 0; level < mlfq_levels; level++)
+    if (mlfq_queue[level] != NULL)
+      return (task_t *)mlfq_queue[level];
+
+  return NULL;
+}
+
+// Eleva todas as tarefas prontas (e a tarefa em execução) ao nível 0
+static void mlfq_boost_all(task_t *running)
+{
+  task_t *task;
+
+  mlfq_epoch++;
+  mlfq_boost_ticks = 0;
+
+  for (int level = 1; level < mlfq_levels; level++)
+  {
+    while (mlfq_queue[level] != NULL)
+    {
+      task = (task_t *)mlfq_queue[level];
+      queue_remove(&mlfq_queue[level], (queue_t *)task);
+      mlfq_ready[level]--;
+      mlfq_set_level(task, 0);
+      queue_append(&mlfq_queue[0], (queue_t *)task);
+      mlfq_ready[0]++;
+    }
+  }
+
+  mlfq_set_level(running, 0);
+}
+
+static int mlfq_tick(task_t *task)
+{
+  mlfq_ticks[task->mlfq_level]++;
+
+  if (++mlfq_boost_ticks >= mlfq_boost)
+    mlfq_boost_all(task);
+
+  // Quantum do nível esgotado: desce um nível
+  if (--task->slice <= 0)
+  {
+    mlfq_demotions[task->mlfq_level]++;
+    mlfq_set_level(task, (task->mlfq_level < mlfq_levels - 1) ? task->mlfq_level + 1
+                                                              : task->mlfq_level);
+    return SCHED_PREEMPT;
+  }
+
+  // Cede a CPU a tarefas prontas em nível mais alto
+  for (int level = 0; level < task->mlfq_level; level++)
+    if (mlfq_ready[level] > 0)
+      return SCHED_PREEMPT;
+
+  return SCHED_CONTINUE;
+}
+
+sched_policy_t sched_mlfq = {
+    .name = "mlfq",
+    .enqueue = mlfq_enqueue,
+    .dequeue = mlfq_dequeue,
+    .pick_next = mlfq_pick_next,
+    .tick = mlfq_tick,
+    .on_wake = no_op,
+    .on_yield = no_op,
+};
+
+// Preenche as estatísticas da política "mlfq"
+int ppos_mlfq_stats(mlfq_stats_t *stats)
+{
+  if (stats == NULL || sched_normal != &sched_mlfq)
+    return -1;
+
+  memset(stats, 0, sizeof(*stats));
+  stats->levels = mlfq_levels;
+  stats->boosts = mlfq_epoch;
+  for (int level = 0; level < mlfq_levels; level++)
+  {
+    stats->quantum[level] = mlfq_quantum(level);
+    stats->ready[level] = mlfq_ready[level];
+    stats->ticks[level] = mlfq_ticks[level];
+    stats->dispatches[level] = mlfq_dispatches[level];
+    stats->demotions[level] = mlfq_demotions[level];
+  }
+
+  return 0;
+}
+
+// Stride scheduling ----------------------------------------------------------
+//
+// Cada tarefa avança seu passo ("pass") em STRIDE1 / bilhetes a cada tick de
+// CPU consumido; executa sempre a tarefa de menor passo. As prontas ficam num
+// heap binário de mínimo indexado por passo (inserção e remoção em O(log n)).
+
+#define STRIDE1 (1ULL << 20) // Passo de uma tarefa com um único bilhete
+
+static task_t **stride_heap = NULL;            // Heap de prontas, por passo
+static int stride_count = 0;                   // Tarefas no heap
+static int stride_capacity = 0;                // Tamanho alocado do heap
+static unsigned long long stride_global = 0;   // Passo da última tarefa escolhida
+
+static int stride_less(int i, int j)
+{
+  return stride_heap[i]->pass < stride_heap[j]->pass;
+}
+
+static void stride_swap(int i, int j)
+{
+  task_t *task = stride_heap[i];
+
+  stride_heap[i] = stride_heap[j];
+  stride_heap[j] = task;
+  stride_heap[i]->heap_index = i;
+  stride_heap[j]->heap_index = j;
+}
+
+// Sobe o elemento i até sua posição no heap
+static void stride_up(int i)
+{
+  while (i > 0 && stride_less(i, (i - 1) / 2))
+  {
+    stride_swap(i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+}
+
+// Desce o elemento i até sua posição no heap
+static void stride_down(int i)
+{
+  int smallest, left, right;
+
+  while (1)
+  {
+    smallest = i;
+    left = 2 * i + 1;
+    right = left + 1;
+    if (left < stride_count && stride_less(left, smallest))
+      smallest = left;
+    if (right < stride_count && stride_less(right, smallest))
+      smallest = right;
+    if (smallest == i)
+      return;
+    stride_swap(i, smallest);
+    i = smallest;
+  }
+}
+
+static void stride_enqueue(task_t *task)
+{
+  // Aumenta o heap quando necessário
+  if (stride_count == stride_capacity)
+  {
+    stride_capacity = stride_capacity ? 2 * stride_capacity : 16;
+    stride_heap = realloc(stride_heap, stride_capacity * sizeof(task_t *));
+    if (stride_heap == NULL)
+    {
+      perror("stride_enqueue: realloc error");
+      exit(1);
+    }
+  }
+
+  stride_heap[stride_count] = task;
+  task->heap_index = stride_count++;
+  stride_up(task->heap_index);
+}
+
+static void stride_dequeue(task_t *task)
+{
+  int i = task->heap_index;
+
+  // O último elemento ocupa a posição liberada e é reposicionado
+  stride_count--;
+  if (i != stride_count)
+  {
+    stride_heap[i] = stride_heap[stride_count];
+    stride_heap[i]->heap_index = i;
+    stride_down(i);
+    stride_up(i);
+  }
+  task->heap_index = -1;
+  task->slice = sched_quantum;
+
+  if (task->pass > stride_global)
+    stride_global = task->pass;
+}
+
+static task_t *stride_pick_next()
+{
+  return stride_count > 0 ? stride_heap[0] : NULL;
+}
+
+// Cobra o tick consumido no passo da tarefa
+static int stride_tick(task_t *task)
+{
+  task->pass += STRIDE1 / task->tickets;
+
+  if (--task->slice > 0)
+    return SCHED_CONTINUE;
+
+  // Fatia esgotada: só cede a CPU se houver outra tarefa pronta
+  if (stride_count > 0)
+    return SCHED_PREEMPT;
+
+  task->slice = sched_quantum;
+  return SCHED_CONTINUE;
+}
+
+// Tarefas novas entram no passo global; tarefas que dormiram não acumulam
+// crédito pelo tempo bloqueado
+static void stride_on_wake(task_t *task)
+{
+  if (task->activations == 0 || task->pass < stride_global)
+    task->pass = stride_global;
+}
+
+sched_policy_t sched_stride = {
+    .name = "stride",
+    .enqueue = stride_enqueue,
+    .dequeue = stride_dequeue,
+    .pick_next = stride_pick_next,
+    .tick = stride_tick,
+    .on_wake = stride_on_wake,
+    .on_yield = no_op,
+};
+
+// Lottery scheduling ---------------------------------------------------------
+//
+// Sorteia um bilhete entre os das tarefas prontas; a fatia de CPU é
+// proporcional aos bilhetes apenas em média. O gerador é próprio do núcleo
+// para não alterar a sequência de random() das aplicações.
+
+static queue_t *lottery_queue = NULL;   // Fila de tarefas prontas
+static unsigned int lottery_seed = 1;   // Estado do gerador (xorshift)
+
+static unsigned int lottery_random()
+{
+  lottery_seed ^= lottery_seed << 13;
+  lottery_seed ^= lottery_seed >> 17;
+  lottery_seed ^= lottery_seed << 5;
+  return lottery_seed;
+}
+
+static void lottery_enqueue(task_t *task)
+{
+  queue_append(&lottery_queue, (queue_t *)task);
+}
+
+static void lottery_dequeue(task_t *task)
+{
+  queue_remove(&lottery_queue, (queue_t *)task);
+  task->slice = sched_quantum;
+}
+
+static task_t *lottery_pick_next()
+{
+  task_t *first = (task_t *)lottery_queue;
+  task_t *current = first;
+  unsigned long total = 0, winner;
+
+  if (first == NULL)
+    return NULL;
+
+  do
+  {
+    total += current->tickets;
+    current = current->next;
+  } while (current != first);
+
+  // Percorre a fila até a tarefa dona do bilhete sorteado
+  winner = lottery_random() % total;
+  while (winner >= current->tickets)
+  {
+    winner -= current->tickets;
+    current = current->next;
+  }
+
+  return current;
+}
+
+sched_policy_t sched_lottery = {
+    .name = "lottery",
+    .enqueue = lottery_enqueue,
+    .dequeue = lottery_dequeue,
+    .pick_next = lottery_pick_next,
+    .tick = slice_tick,
+    .on_wake = no_op,
+    .on_yield = no_op,
+};
+
+// Tabela de políticas da classe normal ---------------------------------------
+
+static sched_policy_t *policies[] = {
+    &sched_prio,
+    &sched_fcfs,
+    &sched_rr,
+    &sched_cfs,
+    &sched_mlfq,
+    &sched_stride,
+    &sched_lottery,
+};
+
+// Retorna a política de classe normal com o nome indicado (ou NULL)
+sched_policy_t *sched_policy_find(const char *name)
+{
+  for (int i = 0; i < sizeof(policies) / sizeof(policies[0]); i++)
+    if (strcmp(policies[i]->name, name) == 0)
+      return policies[i];
+
+  return NULL;
+}
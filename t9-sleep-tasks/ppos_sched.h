@@ -0,0 +1,167 @@
+// PingPongOS - PingPong Operating System
+
+// Interface interna entre o núcleo e as políticas de escalonamento
+
+#ifndef __PPOS_SCHED__
+#define __PPOS_SCHED__
+
+#include "ppos_data.h"
+#include "ppos_ext.h"
+
+// Decisões retornadas pela operação tick() de uma política
+#define SCHED_CONTINUE 0 // A tarefa segue executando
+#define SCHED_PREEMPT 1  // A tarefa volta ao conjunto de prontas
+#define SCHED_THROTTLE 2 // A tarefa fica bloqueada até task->wake_time
+
+#define DEFAULT_PRIO 0      // Prioridade padrão
+#define MIN_PRIO -20        // Prioridade máxima
+#define MAX_PRIO 20         // Prioridade mínima
+#define ALPHA -1            // Fator de envelhecimento padrão
+#define QUANTUM 20          // Quantum padrão (em ticks)
+#define MLFQ_LEVELS 4       // Níveis padrão da política "mlfq"
+#define MLFQ_BOOST 1000     // Período padrão da elevação da política "mlfq" (ticks)
+#define DEFAULT_TICKETS 100 // Bilhetes padrão das políticas "stride" e "lottery"
+#define MAX_TICKETS 100000  // Número máximo de bilhetes por tarefa
+
+#define TICK_INTERVAL 1000                  // Intervalo do temporizador (em microssegundos)
+#define TICK_NS (TICK_INTERVAL * 1000ULL)   // Duração de um tick (em nanossegundos)
+#define NS_PER_MS 1000000ULL                // Nanossegundos por milissegundo
+
+// Operações de uma política de escalonamento. O núcleo mantém uma política
+// por classe e chama estas funções; cada política guarda suas próprias filas.
+typedef struct sched_policy_t
+{
+  const char *name; // Nome usado na configuração (PPOS_SCHED)
+
+  // A tarefa entra no conjunto de prontas (nova, acordada ou de volta da CPU)
+  void (*enqueue)(task_t *task);
+
+  // A tarefa sai do conjunto de prontas (vai executar ou foi suspensa)
+  void (*dequeue)(task_t *task);
+
+  // Escolhe a próxima tarefa a executar, sem retirá-la do conjunto (ou NULL)
+  task_t *(*pick_next)(void);
+
+  // Chamada a cada tick para a tarefa em execução; retorna SCHED_*
+  int (*tick)(task_t *task);
+
+  // A tarefa deixou um estado bloqueado (chamada antes de enqueue)
+  void (*on_wake)(task_t *task);
+
+  // A tarefa deixou a CPU ainda pronta: liberou ou foi preemptada
+  // (chamada antes de enqueue)
+  void (*on_yield)(task_t *task);
+} sched_policy_t;
+
+// Parâmetros ajustáveis, definidos em ppos_init_config()
+extern int sched_quantum; // Quantum das políticas com fatia de tempo (ticks)
+extern int sched_aging;   // Fator de envelhecimento da política "prio"
+extern int mlfq_levels;   // Número de níveis da política "mlfq"
+extern int mlfq_boost;    // Período da elevação da política "mlfq" (ticks)
+
+// Ligado enquanto o dispatcher refaz a escolha de uma mesma decisão (a tarefa
+// escolhida antes foi contida): pick_next não repete efeitos colaterais da
+// escolha anterior, como o envelhecimento
+extern int sched_repick;
+
+// Classe de tempo real por prazo (tarefas SCHED_CLASS_DEADLINE)
+extern sched_policy_t sched_dl;
+
+// Classe de tempo real (tarefas SCHED_CLASS_FIFO e SCHED_CLASS_RR)
+extern sched_policy_t sched_rt;
+
+// Políticas disponíveis para a classe normal
+extern sched_policy_t sched_prio; // Prioridade com envelhecimento (padrão)
+extern sched_policy_t sched_fcfs; // Ordem de chegada, sem preempção por tempo
+extern sched_policy_t sched_rr;   // Round-robin com quantum global
+extern sched_policy_t sched_cfs;  // Justiça proporcional por tempo virtual
+extern sched_policy_t sched_mlfq; // Filas multinível com realimentação
+extern sched_policy_t sched_stride;  // Fatia proporcional aos bilhetes (determinística)
+extern sched_policy_t sched_lottery; // Fatia proporcional aos bilhetes (sorteio)
+
+// Política em uso na classe normal
+extern sched_policy_t *sched_normal;
+
+// Retorna a política de classe normal com o nome indicado (ou NULL)
+sched_policy_t *sched_policy_find(const char *name);
+
+// Bloqueio das primitivas de sincronização (ppos_core.c) -------------------
+
+// Como task_suspend, mas chamada com a preempção desabilitada (uma vez), para
+// que a tarefa entre na fila na mesma seção em que testou o objeto; reabilita
+// a preempção antes de deixar a CPU
+void task_suspend_locked(task_t **queue);
+
+// Como task_suspend_timeout, com a preempção desabilitada como em
+// task_suspend_locked; retorna 0 ou PPOS_ETIMEDOUT (a tarefa já fora da fila).
+// Se o prazo expira, undo(object) é chamada (se não nula) no mesmo instante
+// em que a tarefa deixa a fila, para desfazer o que ela já requisitou ao objeto
+int task_suspend_timeout_locked(task_t **queue, int timeout_ms, void (*undo)(void *),
+                                void *object);
+
+// Registra o motivo (OFFCPU_*), o objeto e o local de chamada do bloqueio que
+// pode seguir, para a análise fora da CPU
+void task_block_mark(int reason, void *object, void *site);
+
+// Controle de banda dos grupos (ppos_group.c) --------------------------------
+
+// Cobra um tick de CPU da tarefa em seu grupo e nos grupos ancestrais
+void group_charge(task_t *task, unsigned long long now);
+
+// Retorna o grupo da tarefa (ou um ancestral) com a cota esgotada, ou NULL
+task_group_t *group_throttled(task_t *task, unsigned long long now);
+
+// Retorna quantos ticks a tarefa ainda pode executar até esgotar a menor cota
+// restante entre seus grupos, ou -1 se nenhum deles tem cota
+int group_quota_ticks(task_t *task, unsigned long long now);
+
+// Temporizadores do núcleo (ppos_timer.c) ------------------------------------
+
+// Informa se algum temporizador vence até o tick "now"
+int ktimer_due(unsigned long long now);
+
+// Avança a roda de tempo até o tick "now", executando os temporizadores vencidos
+// (chamada pelo dispatcher)
+void ktimer_run(unsigned long long now);
+
+// Estatísticas (ppos_core.c e ppos_shm.c) -----------------------------------
+
+// Referência para a taxa de trocas de contexto de um consumidor de estatísticas
+typedef struct
+{
+  unsigned long long time;     // Instante da leitura anterior (ns)
+  unsigned long long switches; // Trocas até a leitura anterior
+} stats_rate_t;
+
+// Preenche as estatísticas do sistema e de até max_tasks tarefas (como
+// ppos_stats_snapshot), com a taxa de trocas medida desde "rate"
+int stats_fill(ppos_stats_t *stats, task_stats_t *tasks, int max_tasks, stats_rate_t *rate);
+
+// Passa a publicar as estatísticas no arquivo "path", mapeado em memória
+// compartilhada (path NULL ou vazio: desligado)
+void stats_shm_init(const char *path);
+
+// Republica as estatísticas se o intervalo de publicação passou (chamada
+// pelo dispatcher)
+void stats_shm_update(unsigned long long now);
+
+// Registro de eventos (ppos_trace.c) ----------------------------------------
+
+// Liga o registro desde a inicialização, salvando-o em "path" ao fim do
+// processo (path NULL ou vazio: desligado)
+void trace_init(const char *path);
+
+// Impede (e volta a permitir) a preempção da tarefa atual enquanto ela
+// altera estruturas do núcleo compartilhadas com o dispatcher
+void preempt_disable();
+void preempt_enable();
+
+// Teste de admissão da classe EDF: reserva a utilização runtime/period da
+// tarefa (substituindo a anterior, se já era EDF) e inicia seu primeiro
+// período. Retorna 0, ou -1 se a utilização total passaria de DL_MAX_UTIL.
+int sched_dl_admit(task_t *task, int period, int runtime, int deadline);
+
+// Libera a utilização reservada por uma tarefa EDF (saída ou troca de classe)
+void sched_dl_release(task_t *task);
+
+#endif
@@ -0,0 +1,69 @@
+// PingPongOS - PingPong Operating System
+
+// Publicação das estatísticas em memória compartilhada (ver ppos_shm.h)
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+#include "ppos_sched.h"
+#include "ppos_shm.h"
+
+static stats_shm_t *shm = NULL;                // Região mapeada (NULL: desligado)
+static stats_rate_t shm_rate;                  // Referência da taxa de trocas publicada
+static unsigned long long next_publish = 0;    // Próxima publicação (ns)
+
+// Cria o arquivo de estatísticas e o mapeia em memória compartilhada
+void stats_shm_init(const char *path)
+{
+  void *map;
+  int fd;
+
+  if (path == NULL || *path == '\0')
+    return;
+
+  fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || ftruncate(fd, sizeof(stats_shm_t)) < 0)
+  {
+    perror("ppos: stats");
+    if (fd >= 0)
+      close(fd);
+    return;
+  }
+
+  map = mmap(NULL, sizeof(stats_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+  {
+    perror("ppos: stats");
+    return;
+  }
+
+  shm = map;
+  shm->version = STATS_VERSION;
+  shm->pid = getpid();
+  shm->max_tasks = STATS_MAX_TASKS;
+  shm->seq = 0;
+  shm->ntasks = 0;
+  memcpy(shm->magic, STATS_MAGIC, 4); // Por último: o arquivo está pronto
+}
+
+// Republica as estatísticas se o intervalo de publicação passou
+void stats_shm_update(unsigned long long now)
+{
+  if (shm == NULL || now < next_publish)
+    return;
+
+  next_publish = now + STATS_INTERVAL * NS_PER_MS;
+
+  // Seqlock: leitores que vejam "seq" ímpar, ou diferente ao fim da cópia,
+  // descartam a leitura
+  shm->seq++;
+  __sync_synchronize();
+  shm->ntasks = stats_fill(&shm->sys, shm->tasks, STATS_MAX_TASKS, &shm_rate);
+  __sync_synchronize();
+  shm->seq++;
+}
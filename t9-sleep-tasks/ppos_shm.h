@@ -0,0 +1,31 @@
+// PingPongOS - PingPong Operating System
+
+// Formato do arquivo de estatísticas publicado em memória compartilhada
+// (PPOS_STATS_FILE), lido pela ferramenta ppos-top. O dispatcher reescreve
+// o conteúdo periodicamente, protegido por um seqlock: "seq" é ímpar
+// durante a escrita, e um leitor que veja o mesmo valor par antes e depois
+// de copiar obteve uma cópia consistente.
+
+#ifndef __PPOS_SHM__
+#define __PPOS_SHM__
+
+#include "ppos_ext.h"
+
+#define STATS_MAGIC "PPST"    // Identificação do arquivo
+#define STATS_VERSION 2
+#define STATS_MAX_TASKS 1024  // Tarefas publicadas (as demais são omitidas)
+#define STATS_INTERVAL 100    // Intervalo de publicação (ms)
+
+typedef struct
+{
+  char magic[4];                        // STATS_MAGIC
+  unsigned int version;                 // STATS_VERSION
+  int pid;                              // Processo que publica
+  int max_tasks;                        // STATS_MAX_TASKS
+  volatile unsigned int seq;            // Seqlock (ímpar: escrita em curso)
+  int ntasks;                           // Tarefas em "tasks"
+  ppos_stats_t sys;                     // Estatísticas do sistema
+  task_stats_t tasks[STATS_MAX_TASKS];  // Estatísticas das tarefas
+} stats_shm_t;
+
+#endif
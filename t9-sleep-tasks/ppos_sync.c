@@ -0,0 +1,269 @@
+// PingPongOS - PingPong Operating System
+
+// Semáforos e mutexes. As filas são atendidas em ordem de chegada; o mutex
+// é entregue diretamente à primeira tarefa da fila ao ser liberado, de modo
+// que uma tarefa recém-chegada não o tome de quem já esperava. Com o
+// registro de contenção ligado (PPOS_LOCKSTAT), cada objeto acumula suas
+// estatísticas (ver ppos_lockstat.h).
+
+#include "ppos.h"
+#include "ppos_ext.h"
+#include "ppos_sched.h"
+#include "ppos_offcpu.h"
+#include "ppos_lockstat.h"
+
+// Acorda todas as tarefas de uma fila (objeto destruído)
+static void wake_all(task_t **queue)
+{
+  while (*queue != NULL)
+    task_awake(*queue, queue);
+}
+
+// Inicializa um semáforo com valor inicial "value"
+int sem_init(semaphore_t *s, int value)
+{
+  if (s == NULL)
+    return -1;
+
+  preempt_disable();
+  s->value = value;
+  s->queue = NULL;
+  s->active = 1;
+  lockstat_register(&s->stats, LOCKSTAT_SEM);
+  preempt_enable();
+
+  return 0;
+}
+
+// Desfaz a requisição de uma tarefa que desistiu de esperar pelo semáforo;
+// chamada quando ela deixa a fila, para que um sem_up() seguinte não tente
+// acordá-la
+static void sem_undo(void *object)
+{
+  semaphore_t *s = object;
+
+  if (s->active)
+    s->value++;
+}
+
+// Requisita o semáforo, bloqueando por até timeout_ms enquanto seu valor
+// for negativo; "site" é o local da chamada, para as estatísticas
+static int sem_acquire(semaphore_t *s, int timeout_ms, void *site)
+{
+  unsigned long long wait = 0;
+
+  if (s == NULL || !s->active)
+    return -1;
+
+  preempt_disable();
+  if (--s->value < 0)
+  {
+    wait = systime_ns();
+    task_block_mark(OFFCPU_SEM, s, site);
+    // Fora da fila sem ter recebido o semáforo (requisição já desfeita)
+    if (task_suspend_timeout_locked(&s->queue, timeout_ms, sem_undo, s) == PPOS_ETIMEDOUT)
+      return s->active ? PPOS_ETIMEDOUT : -1;
+    preempt_disable();
+
+    // Acordada pela destruição do semáforo
+    if (!s->active)
+    {
+      preempt_enable();
+      return -1;
+    }
+    wait = systime_ns() - wait;
+  }
+  lockstat_acquire(&s->stats, wait, site);
+  preempt_enable();
+
+  return 0;
+}
+
+// Requisita o semáforo
+int sem_down(semaphore_t *s)
+{
+  return sem_acquire(s, -1, __builtin_return_address(0));
+}
+
+// Requisita o semáforo, desistindo após timeout_ms
+int sem_down_timeout(semaphore_t *s, int timeout_ms)
+{
+  return sem_acquire(s, timeout_ms, __builtin_return_address(0));
+}
+
+// Libera o semáforo, acordando a primeira tarefa da fila
+int sem_up(semaphore_t *s)
+{
+  if (s == NULL || !s->active)
+    return -1;
+
+  preempt_disable();
+  lockstat_release(&s->stats);
+  if (s->value++ < 0)
+    task_awake(s->queue, &s->queue);
+  preempt_enable();
+
+  return 0;
+}
+
+// Destroi o semáforo; as tarefas bloqueadas retornam erro de sem_down
+int sem_destroy(semaphore_t *s)
+{
+  if (s == NULL || !s->active)
+    return -1;
+
+  preempt_disable();
+  s->active = 0;
+  wake_all(&s->queue);
+  lockstat_unregister(&s->stats);
+  preempt_enable();
+
+  return 0;
+}
+
+// Inicializa um mutex livre
+int mutex_init(mutex_t *m)
+{
+  if (m == NULL)
+    return -1;
+
+  preempt_disable();
+  m->locked = 0;
+  m->owner = -1;
+  m->queue = NULL;
+  m->active = 1;
+  lockstat_register(&m->stats, LOCKSTAT_MUTEX);
+  preempt_enable();
+
+  return 0;
+}
+
+// Requisita o mutex; ocupado, a tarefa espera por até timeout_ms que ele
+// lhe seja entregue
+static int mutex_acquire(mutex_t *m, int timeout_ms, void *site)
+{
+  unsigned long long wait = 0;
+
+  if (m == NULL || !m->active)
+    return -1;
+
+  preempt_disable();
+  if (!m->locked)
+  {
+    m->locked = 1;
+    m->owner = task_id();
+  }
+  else
+  {
+    wait = systime_ns();
+    task_block_mark(OFFCPU_MUTEX, m, site);
+
+    // Fora da fila sem ter recebido o mutex
+    if (task_suspend_timeout_locked(&m->queue, timeout_ms, NULL, NULL) == PPOS_ETIMEDOUT)
+      return m->active ? PPOS_ETIMEDOUT : -1;
+    preempt_disable();
+
+    // Acordada pela destruição do mutex
+    if (!m->active)
+    {
+      preempt_enable();
+      return -1;
+    }
+    wait = systime_ns() - wait;
+  }
+  lockstat_acquire(&m->stats, wait, site);
+  preempt_enable();
+
+  return 0;
+}
+
+// Requisita o mutex
+int mutex_lock(mutex_t *m)
+{
+  return mutex_acquire(m, -1, __builtin_return_address(0));
+}
+
+// Requisita o mutex, desistindo após timeout_ms
+int mutex_lock_timeout(mutex_t *m, int timeout_ms)
+{
+  return mutex_acquire(m, timeout_ms, __builtin_return_address(0));
+}
+
+// Libera o mutex, entregando-o à primeira tarefa da fila
+int mutex_unlock(mutex_t *m)
+{
+  if (m == NULL || !m->active || !m->locked || m->owner != task_id())
+    return -1;
+
+  preempt_disable();
+  lockstat_release(&m->stats);
+  if (m->queue != NULL)
+  {
+    m->owner = m->queue->id;
+    task_awake(m->queue, &m->queue);
+  }
+  else
+    m->locked = 0;
+  preempt_enable();
+
+  return 0;
+}
+
+// Destroi o mutex; as tarefas bloqueadas retornam erro de mutex_lock
+int mutex_destroy(mutex_t *m)
+{
+  if (m == NULL || !m->active)
+    return -1;
+
+  preempt_disable();
+  m->active = 0;
+  wake_all(&m->queue);
+  lockstat_unregister(&m->stats);
+  preempt_enable();
+
+  return 0;
+}
+
+// Dá nome ao semáforo nas estatísticas de contenção
+int sem_setname(semaphore_t *s, const char *name)
+{
+  if (s == NULL || !s->active)
+    return -1;
+
+  lockstat_setname(&s->stats, name);
+  return 0;
+}
+
+// Dá nome ao mutex nas estatísticas de contenção
+int mutex_setname(mutex_t *m, const char *name)
+{
+  if (m == NULL || !m->active)
+    return -1;
+
+  lockstat_setname(&m->stats, name);
+  return 0;
+}
+
+// Copia as estatísticas de contenção do semáforo
+int sem_getstats(semaphore_t *s, lock_stats_t *stats)
+{
+  if (s == NULL || stats == NULL)
+    return -1;
+
+  preempt_disable();
+  *stats = s->stats;
+  preempt_enable();
+  return 0;
+}
+
+// Copia as estatísticas de contenção do mutex
+int mutex_getstats(mutex_t *m, lock_stats_t *stats)
+{
+  if (m == NULL || stats == NULL)
+    return -1;
+
+  preempt_disable();
+  *stats = m->stats;
+  preempt_enable();
+  return 0;
+}
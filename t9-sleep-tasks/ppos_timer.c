@@ -0,0 +1,199 @@
+// PingPongOS - PingPong Operating System
+
+// Temporizadores do núcleo, guardados em uma roda hierárquica de tempo:
+// WHEEL_LEVELS níveis de WHEEL_SIZE posições, cada nível com resolução
+// WHEEL_SIZE vezes maior que a do anterior. Armar e cancelar custam O(1);
+// a cada tick o dispatcher expira a posição corrente do nível 0 e, quando
+// ela volta ao início, redistribui uma posição do nível seguinte.
+
+#include "ppos.h"
+#include "ppos_ext.h"
+#include "ppos_sched.h"
+
+#define WHEEL_BITS 6                        // Bits de tempo por nível
+#define WHEEL_SIZE (1 << WHEEL_BITS)        // Posições por nível
+#define WHEEL_MASK (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS 4                      // Alcance: 2^24 ticks (~4,6 horas)
+#define WHEEL_SPAN (1ULL << (WHEEL_BITS * WHEEL_LEVELS))
+
+static ktimer_t *wheel[WHEEL_LEVELS][WHEEL_SIZE]; // Listas circulares de temporizadores
+static unsigned long long wheel_now = 0;          // Último tick processado
+static int timer_count = 0;                       // Temporizadores armados
+
+// Insere o temporizador no final de uma posição da roda
+static void slot_append(ktimer_t **slot, ktimer_t *timer)
+{
+  if (*slot == NULL)
+  {
+    timer->prev = timer->next = timer;
+    *slot = timer;
+  }
+  else
+  {
+    timer->next = *slot;
+    timer->prev = (*slot)->prev;
+    (*slot)->prev->next = timer;
+    (*slot)->prev = timer;
+  }
+  timer->slot = slot;
+}
+
+// Retira o temporizador da posição da roda em que está
+static void slot_remove(ktimer_t *timer)
+{
+  ktimer_t **slot = timer->slot;
+
+  if (timer->next == timer)
+    *slot = NULL;
+  else
+  {
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+    if (*slot == timer)
+      *slot = timer->next;
+  }
+  timer->prev = timer->next = NULL;
+  timer->slot = NULL;
+}
+
+// Coloca o temporizador no nível cujo alcance cobre o tempo que falta;
+// prazos além do alcance da roda ficam na última posição alcançável e são
+// redistribuídos quando ela for processada
+static void wheel_insert(ktimer_t *timer)
+{
+  unsigned long long pos = timer->expires;
+  int level = 0;
+
+  if (pos - wheel_now >= WHEEL_SPAN)
+    pos = wheel_now + WHEEL_SPAN - 1;
+
+  while (level < WHEEL_LEVELS - 1 && pos - wheel_now >= (1ULL << (WHEEL_BITS * (level + 1))))
+    level++;
+
+  slot_append(&wheel[level][(pos >> (WHEEL_BITS * level)) & WHEEL_MASK], timer);
+}
+
+// Redistribui a posição corrente de um nível pelos níveis inferiores
+static void wheel_cascade(int level)
+{
+  int index = (wheel_now >> (WHEEL_BITS * level)) & WHEEL_MASK;
+  ktimer_t *timer;
+
+  // O nível seguinte também virou: ele é redistribuído primeiro
+  if (index == 0 && level < WHEEL_LEVELS - 1)
+    wheel_cascade(level + 1);
+
+  while ((timer = wheel[level][index]) != NULL)
+  {
+    slot_remove(timer);
+    wheel_insert(timer);
+  }
+}
+
+// Inicializa um temporizador desarmado
+void ktimer_init(ktimer_t *timer, void (*callback)(ktimer_t *timer, void *arg), void *arg)
+{
+  timer->prev = timer->next = NULL;
+  timer->slot = NULL;
+  timer->expires = 0;
+  timer->slack = 0;
+  timer->callback = callback;
+  timer->arg = arg;
+}
+
+// Arma (ou rearma) o temporizador para daqui a timeout_ms
+int ktimer_arm(ktimer_t *timer, int timeout_ms)
+{
+  if (timer == NULL || timer->callback == NULL)
+    return -1;
+
+  if (timeout_ms < 1)
+    timeout_ms = 1;
+
+  preempt_disable();
+  if (timer->slot != NULL)
+    slot_remove(timer);
+  else
+    timer_count++;
+  timer->expires = systime_ns() / NS_PER_MS + timeout_ms;
+  if (timer->slack > 1)
+    timer->expires = (timer->expires + timer->slack - 1) / timer->slack * timer->slack;
+  wheel_insert(timer);
+  preempt_enable();
+
+  return 0;
+}
+
+// Cancela o temporizador; retorna 1 se ele ainda estava armado
+int ktimer_cancel(ktimer_t *timer)
+{
+  if (timer == NULL || timer->slot == NULL)
+    return 0;
+
+  preempt_disable();
+  slot_remove(timer);
+  timer_count--;
+  preempt_enable();
+
+  return 1;
+}
+
+// Informa se algum temporizador vence até o tick "now"
+int ktimer_due(unsigned long long now)
+{
+  unsigned long long tick;
+  int level, index;
+
+  if (timer_count == 0)
+    return 0;
+
+  // A roda ficou uma volta inteira sem ser processada
+  if (now - wheel_now >= WHEEL_SIZE)
+    return 1;
+
+  for (tick = wheel_now + 1; tick <= now; tick++)
+  {
+    if (wheel[0][tick & WHEEL_MASK] != NULL)
+      return 1;
+
+    // Redistribuições que ocorrem neste tick podem trazer temporizadores
+    for (level = 1; level < WHEEL_LEVELS && (tick & ((1ULL << (WHEEL_BITS * level)) - 1)) == 0; level++)
+    {
+      index = (tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+      if (wheel[level][index] != NULL)
+        return 1;
+    }
+  }
+
+  return 0;
+}
+
+// Avança a roda até o tick "now", executando os temporizadores vencidos
+void ktimer_run(unsigned long long now)
+{
+  ktimer_t *timer;
+  int index;
+
+  while (wheel_now < now)
+  {
+    // Sem temporizadores, a roda pode saltar direto para "now"
+    if (timer_count == 0)
+    {
+      wheel_now = now;
+      return;
+    }
+
+    wheel_now++;
+    index = wheel_now & WHEEL_MASK;
+    if (index == 0)
+      wheel_cascade(1);
+
+    // A função pode rearmar o próprio temporizador (sempre para um tick futuro)
+    while ((timer = wheel[0][index]) != NULL)
+    {
+      slot_remove(timer);
+      timer_count--;
+      timer->callback(timer, timer->arg);
+    }
+  }
+}
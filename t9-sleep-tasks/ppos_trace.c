@@ -0,0 +1,93 @@
+// PingPongOS - PingPong Operating System
+
+// Anel de registros de eventos do escalonador (ver ppos_trace.h)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+#include "ppos_sched.h"
+#include "ppos_trace.h"
+
+volatile int trace_enabled = 0;
+
+static trace_record_t trace_ring[TRACE_RECORDS]; // Anel de registros
+static unsigned long long trace_head = 0;        // Registros gravados desde o início
+static const char *trace_path = NULL;            // Arquivo salvo ao fim do processo
+
+// Grava um evento no anel, sobrescrevendo o mais antigo se estiver cheio
+void trace_record(int type, int task, long long arg)
+{
+  trace_record_t *rec;
+
+  // Sem preempção: o tratador de ticks também grava eventos
+  preempt_disable();
+  rec = &trace_ring[trace_head++ % TRACE_RECORDS];
+  rec->time = systime_ns();
+  rec->type = type;
+  rec->task = task;
+  rec->arg = arg;
+  preempt_enable();
+}
+
+// Liga a gravação de eventos, descartando os anteriores
+void trace_start()
+{
+  preempt_disable();
+  trace_head = 0;
+  preempt_enable();
+  trace_enabled = 1;
+}
+
+// Desliga a gravação de eventos (o anel é mantido para trace_dump())
+void trace_stop()
+{
+  trace_enabled = 0;
+}
+
+// Salva os eventos do anel no arquivo indicado
+int trace_dump(const char *path)
+{
+  trace_header_t header;
+  unsigned long long first, i;
+  FILE *file;
+  int enabled = trace_enabled;
+
+  if (path == NULL || (file = fopen(path, "wb")) == NULL)
+    return -1;
+
+  // A gravação fica suspensa enquanto o anel é copiado
+  trace_enabled = 0;
+  first = (trace_head > TRACE_RECORDS) ? trace_head - TRACE_RECORDS : 0;
+  memcpy(header.magic, TRACE_MAGIC, 4);
+  header.version = TRACE_VERSION;
+  header.count = trace_head - first;
+  header.lost = first;
+  fwrite(&header, sizeof(header), 1, file);
+  for (i = first; i < trace_head; i++)
+    fwrite(&trace_ring[i % TRACE_RECORDS], sizeof(trace_record_t), 1, file);
+  trace_enabled = enabled;
+
+  return fclose(file);
+}
+
+// Salva o anel no arquivo de trace_init() ao fim do processo
+static void trace_atexit()
+{
+  trace_stop();
+  if (trace_dump(trace_path) < 0)
+    perror("ppos: trace");
+}
+
+// Liga a gravação desde a inicialização, salvando o anel em "path" ao fim
+// do processo
+void trace_init(const char *path)
+{
+  if (path == NULL || *path == '\0')
+    return;
+
+  trace_path = path;
+  atexit(trace_atexit);
+  trace_start();
+}
@@ -0,0 +1,58 @@
+// PingPongOS - PingPong Operating System
+
+// Registro binário de eventos do escalonador. O núcleo grava registros
+// compactos num anel de tamanho fixo; trace_dump() os salva em arquivo,
+// que a ferramenta ppos-trace converte para o formato JSON do Chrome.
+// Este arquivo é compartilhado com a ferramenta, por isso não usa ppos.h.
+
+#ifndef __PPOS_TRACE__
+#define __PPOS_TRACE__
+
+#define TRACE_RECORDS (1 << 16) // Registros guardados no anel
+#define TRACE_MAGIC "PPTR"      // Identificação do arquivo
+#define TRACE_VERSION 1
+
+// Tipos de evento (o significado de "arg" está ao lado)
+#define TRACE_SWITCH 1   // a tarefa deixa a CPU; arg: tarefa que a recebe
+#define TRACE_SUSPEND 2  // a tarefa se suspende; arg: 0
+#define TRACE_WAKE 3     // a tarefa é acordada; arg: tarefa que a acordou
+#define TRACE_SLEEP 4    // a tarefa adormece; arg: instante de acordar (ns)
+#define TRACE_WAKEUP 5   // a tarefa adormecida acorda; arg: atraso (ns)
+#define TRACE_PREEMPT 6  // o tick tira a CPU da tarefa; arg: decisão SCHED_*
+#define TRACE_EXIT 7     // a tarefa termina; arg: código de saída
+#define TRACE_THROTTLE 8 // a tarefa é contida (orçamento ou cota esgotados);
+                         // arg: instante de liberação (ns)
+
+// Registro de um evento
+typedef struct
+{
+  unsigned long long time; // instante, em ns desde a inicialização
+  int type;                // TRACE_*
+  int task;                // tarefa à qual o evento se refere
+  long long arg;           // argumento do evento
+} trace_record_t;
+
+// Cabeçalho do arquivo; seguem os registros, do mais antigo ao mais recente
+typedef struct
+{
+  char magic[4];        // TRACE_MAGIC
+  unsigned int version; // TRACE_VERSION
+  unsigned int count;   // número de registros no arquivo
+  unsigned int lost;    // registros sobrescritos no anel antes da gravação
+} trace_header_t;
+
+// Gravação ligada (ver trace_start())
+extern volatile int trace_enabled;
+
+// Grava um evento no anel (usar TRACE())
+void trace_record(int type, int task, long long arg);
+
+// Grava um evento se a gravação está ligada; desligada, custa um teste
+#define TRACE(type, task, arg)          \
+  do                                    \
+  {                                     \
+    if (trace_enabled)                  \
+      trace_record(type, task, arg);    \
+  } while (0)
+
+#endif
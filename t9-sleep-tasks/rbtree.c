@@ -0,0 +1,276 @@
+// PingPongOS - PingPong Operating System
+// Árvore rubro-negra genérica e intrusiva (algoritmos de Cormen et al.,
+// com NULL no lugar do nó sentinela)
+
+#include "rbtree.h"
+
+#define RB_RED 0
+#define RB_BLACK 1
+
+//------------------------------------------------------------------------------
+// Um nó ausente (NULL) é considerado preto
+
+static inline int is_black(rb_node_t *node) {
+    return (node == NULL || node->color == RB_BLACK);
+}
+
+static rb_node_t *subtree_min(rb_node_t *node) {
+    while (node->left != NULL) {
+        node = node->left;
+    }
+    return node;
+}
+
+//------------------------------------------------------------------------------
+// Substitui, no pai de "old", a subárvore "old" pela subárvore "new"
+
+static void replace_child(rb_tree_t *tree, rb_node_t *old, rb_node_t *new) {
+    if (old->parent == NULL) {
+        tree->root = new;
+    } else if (old == old->parent->left) {
+        old->parent->left = new;
+    } else {
+        old->parent->right = new;
+    }
+
+    if (new != NULL) {
+        new->parent = old->parent;
+    }
+}
+
+static void rotate_left(rb_tree_t *tree, rb_node_t *x) {
+    rb_node_t *y = x->right;
+
+    x->right = y->left;
+    if (y->left != NULL) {
+        y->left->parent = x;
+    }
+    replace_child(tree, x, y);
+    y->left = x;
+    x->parent = y;
+}
+
+static void rotate_right(rb_tree_t *tree, rb_node_t *x) {
+    rb_node_t *y = x->left;
+
+    x->left = y->right;
+    if (y->right != NULL) {
+        y->right->parent = x;
+    }
+    replace_child(tree, x, y);
+    y->right = x;
+    x->parent = y;
+}
+
+//------------------------------------------------------------------------------
+// Restaura as propriedades da árvore após inserir o nó vermelho "node"
+
+static void insert_fixup(rb_tree_t *tree, rb_node_t *node) {
+    rb_node_t *parent, *grandparent, *uncle;
+
+    while ((parent = node->parent) != NULL && parent->color == RB_RED) {
+        // o pai é vermelho, portanto não é a raiz e o avô existe
+        grandparent = parent->parent;
+
+        if (parent == grandparent->left) {
+            uncle = grandparent->right;
+            if (!is_black(uncle)) {
+                // tio vermelho: recolore e sobe dois níveis
+                parent->color = RB_BLACK;
+                uncle->color = RB_BLACK;
+                grandparent->color = RB_RED;
+                node = grandparent;
+                continue;
+            }
+            if (node == parent->right) {
+                rotate_left(tree, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RB_BLACK;
+            grandparent->color = RB_RED;
+            rotate_right(tree, grandparent);
+        } else {
+            uncle = grandparent->left;
+            if (!is_black(uncle)) {
+                parent->color = RB_BLACK;
+                uncle->color = RB_BLACK;
+                grandparent->color = RB_RED;
+                node = grandparent;
+                continue;
+            }
+            if (node == parent->left) {
+                rotate_right(tree, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RB_BLACK;
+            grandparent->color = RB_RED;
+            rotate_left(tree, grandparent);
+        }
+    }
+
+    tree->root->color = RB_BLACK;
+}
+
+//------------------------------------------------------------------------------
+// Restaura as propriedades da árvore após remover um nó preto; "node" (talvez
+// NULL) ocupa a posição removida e "parent" é seu pai
+
+static void remove_fixup(rb_tree_t *tree, rb_node_t *node, rb_node_t *parent) {
+    rb_node_t *sibling;
+
+    while (node != tree->root && is_black(node)) {
+        // o ramo de "node" tem um preto a menos, então o irmão existe
+        if (node == parent->left) {
+            sibling = parent->right;
+            if (!is_black(sibling)) {
+                sibling->color = RB_BLACK;
+                parent->color = RB_RED;
+                rotate_left(tree, parent);
+                sibling = parent->right;
+            }
+            if (is_black(sibling->left) && is_black(sibling->right)) {
+                sibling->color = RB_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (is_black(sibling->right)) {
+                sibling->left->color = RB_BLACK;
+                sibling->color = RB_RED;
+                rotate_right(tree, sibling);
+                sibling = parent->right;
+            }
+            sibling->color = parent->color;
+            parent->color = RB_BLACK;
+            sibling->right->color = RB_BLACK;
+            rotate_left(tree, parent);
+        } else {
+            sibling = parent->left;
+            if (!is_black(sibling)) {
+                sibling->color = RB_BLACK;
+                parent->color = RB_RED;
+                rotate_right(tree, parent);
+                sibling = parent->left;
+            }
+            if (is_black(sibling->left) && is_black(sibling->right)) {
+                sibling->color = RB_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (is_black(sibling->left)) {
+                sibling->right->color = RB_BLACK;
+                sibling->color = RB_RED;
+                rotate_left(tree, sibling);
+                sibling = parent->left;
+            }
+            sibling->color = parent->color;
+            parent->color = RB_BLACK;
+            sibling->left->color = RB_BLACK;
+            rotate_right(tree, parent);
+        }
+        node = tree->root;
+    }
+
+    if (node != NULL) {
+        node->color = RB_BLACK;
+    }
+}
+
+void rb_insert(rb_tree_t *tree, rb_node_t *node, rb_less_t less) {
+    rb_node_t *parent = NULL;
+    rb_node_t *current = tree->root;
+    int go_left = 0;
+    int leftmost = 1;
+
+    // Desce até uma folha, lembrando se o caminho foi sempre para a esquerda
+    while (current != NULL) {
+        parent = current;
+        go_left = less(node, current);
+        if (go_left) {
+            current = current->left;
+        } else {
+            current = current->right;
+            leftmost = 0;
+        }
+    }
+
+    node->parent = parent;
+    node->left = node->right = NULL;
+    node->color = RB_RED;
+
+    if (parent == NULL) {
+        tree->root = node;
+    } else if (go_left) {
+        parent->left = node;
+    } else {
+        parent->right = node;
+    }
+
+    if (leftmost) {
+        tree->leftmost = node;
+    }
+
+    insert_fixup(tree, node);
+}
+
+void rb_remove(rb_tree_t *tree, rb_node_t *node) {
+    rb_node_t *child, *parent, *next;
+    int removed_color = node->color;
+
+    if (tree->leftmost == node) {
+        tree->leftmost = rb_next(node);
+    }
+
+    if (node->left == NULL) {
+        child = node->right;
+        parent = node->parent;
+        replace_child(tree, node, child);
+    } else if (node->right == NULL) {
+        child = node->left;
+        parent = node->parent;
+        replace_child(tree, node, child);
+    } else {
+        // dois filhos: o sucessor ocupa o lugar do nó removido
+        next = subtree_min(node->right);
+        removed_color = next->color;
+        child = next->right;
+
+        if (next->parent == node) {
+            parent = next;
+        } else {
+            parent = next->parent;
+            replace_child(tree, next, child);
+            next->right = node->right;
+            next->right->parent = next;
+        }
+
+        replace_child(tree, node, next);
+        next->left = node->left;
+        next->left->parent = next;
+        next->color = node->color;
+    }
+
+    if (removed_color == RB_BLACK) {
+        remove_fixup(tree, child, parent);
+    }
+
+    node->parent = node->left = node->right = NULL;
+}
+
+rb_node_t *rb_first(rb_tree_t *tree) {
+    return tree->leftmost;
+}
+
+rb_node_t *rb_next(rb_node_t *node) {
+    if (node->right != NULL) {
+        return subtree_min(node->right);
+    }
+
+    while (node->parent != NULL && node == node->parent->right) {
+        node = node->parent;
+    }
+    return node->parent;
+}
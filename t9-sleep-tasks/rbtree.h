@@ -0,0 +1,56 @@
+// PingPongOS - PingPong Operating System
+// Definição e operações em uma árvore rubro-negra genérica e intrusiva.
+
+#ifndef __RBTREE__
+#define __RBTREE__
+
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// nó da árvore, embutido na estrutura do elemento (como queue_t nas filas);
+// o elemento é recuperado a partir do nó com rb_entry()
+
+typedef struct rb_node_t
+{
+   struct rb_node_t *parent ; // nó pai (NULL na raiz)
+   struct rb_node_t *left ;   // subárvore esquerda (chaves menores)
+   struct rb_node_t *right ;  // subárvore direita (chaves maiores ou iguais)
+   int color ;                // RB_RED ou RB_BLACK
+} rb_node_t ;
+
+// árvore: raiz e cache do nó mais à esquerda (menor chave)
+typedef struct rb_tree_t
+{
+   rb_node_t *root ;
+   rb_node_t *leftmost ;
+} rb_tree_t ;
+
+// função de comparação: retorna não-zero se a chave de a for menor que a de b
+typedef int (*rb_less_t) (const rb_node_t *a, const rb_node_t *b) ;
+
+// recupera o elemento que contém o nó "ptr", embutido no campo "member"
+#define rb_entry(ptr, type, member) \
+   ((type *) ((char *) (ptr) - offsetof (type, member)))
+
+//------------------------------------------------------------------------------
+// Insere um nó na árvore, na posição definida por "less". Chaves iguais são
+// inseridas à direita das existentes (ordem de chegada). Custo O(log n).
+
+void rb_insert (rb_tree_t *tree, rb_node_t *node, rb_less_t less) ;
+
+//------------------------------------------------------------------------------
+// Remove o nó indicado, que deve pertencer à árvore. Custo O(log n).
+
+void rb_remove (rb_tree_t *tree, rb_node_t *node) ;
+
+//------------------------------------------------------------------------------
+// Retorna o nó de menor chave (ou NULL se a árvore estiver vazia). Custo O(1).
+
+rb_node_t *rb_first (rb_tree_t *tree) ;
+
+//------------------------------------------------------------------------------
+// Retorna o sucessor do nó em ordem crescente de chave (ou NULL).
+
+rb_node_t *rb_next (rb_node_t *node) ;
+
+#endif
@@ -0,0 +1,87 @@
+// PingPongOS - PingPong Operating System
+
+// Teste da política "cfs" - variante de test2-distinct-priority.c (t7):
+// tarefas com prioridades distintas disputam a CPU por um tempo fixo e a
+// fatia de CPU obtida por cada uma deve ser proporcional ao seu peso
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define RUNTIME 5000   // duração da disputa (ms)
+#define TOLERANCE 0.10 // desvio relativo máximo da fatia esperada
+
+task_t Pang, Peng, Ping, Pong, Pung;
+
+// pesos da política "cfs" para as prioridades 0, -2, -4, -6 e -8
+int prio[5] = {0, -2, -4, -6, -8};
+int weight[5] = {1024, 1586, 2501, 3906, 6100};
+
+// simula um processamento pesado
+int hardwork(int n)
+{
+  int i, j, soma;
+
+  soma = 0;
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+      soma += j;
+  return (soma);
+}
+
+// corpo das threads: processa até o fim da disputa
+void Body(void *arg)
+{
+  printf("%s: inicio em %4d ms (prio: %d)\n", (char *)arg,
+         systime(), task_getprio(NULL));
+  while (systime() < RUNTIME)
+    hardwork(100);
+  printf("%s: fim    em %4d ms\n", (char *)arg, systime());
+  task_exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {.sched_policy = "cfs"};
+  task_t *tasks[5] = {&Pang, &Peng, &Ping, &Pong, &Pung};
+  char *names[5] = {"    Pang", "        Peng", "            Ping",
+                    "                Pong", "                    Pung"};
+  unsigned int total_cpu = 0;
+  int i, ok, total_weight = 0, errors = 0;
+  double share, expected;
+
+  printf("main: inicio\n");
+
+  ppos_init_config(&config);
+
+  for (i = 0; i < 5; i++)
+  {
+    task_init(tasks[i], Body, names[i]);
+    task_setprio(tasks[i], prio[i]);
+  }
+
+  for (i = 0; i < 5; i++)
+    task_wait(tasks[i]);
+
+  for (i = 0; i < 5; i++)
+  {
+    total_cpu += tasks[i]->processor_time;
+    total_weight += weight[i];
+  }
+
+  // compara a fatia de CPU de cada tarefa com a fatia esperada pelo peso
+  for (i = 0; i < 5; i++)
+  {
+    share = (double)tasks[i]->processor_time / total_cpu;
+    expected = (double)weight[i] / total_weight;
+    ok = (share >= expected * (1 - TOLERANCE) && share <= expected * (1 + TOLERANCE));
+    if (!ok)
+      errors++;
+    printf("main: tarefa %d (prio %3d): cpu %5.1f%%, esperado %5.1f%% (%s)\n",
+           tasks[i]->id, prio[i], 100 * share, 100 * expected, ok ? "ok" : "ERROR");
+  }
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
@@ -0,0 +1,60 @@
+// PingPongOS - PingPong Operating System
+
+// Teste dos ticks pelo relógio de CPU (PPOS_TICK_CLOCK=virtual): tarefas que
+// processam sem parar ainda se revezam, mas a classe EDF é recusada e as
+// seções críticas não recebem extensão da fatia, pois um único sinal do
+// relógio de CPU do hospedeiro pode cobrar vários ticks.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define RUNTIME 300 // duração da disputa (ms)
+
+task_t Pang, Peng;
+
+// processa até o fim da disputa, sempre em seção crítica
+void Body(void *arg)
+{
+  task_cs_begin();
+  while (systime() < RUNTIME)
+    ;
+  task_cs_end();
+  task_exit(0);
+}
+
+// confere uma condição do teste
+int check(int ok, const char *what)
+{
+  printf("main: %s (%s)\n", what, ok ? "ok" : "ERROR");
+  return !ok;
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {.quantum = 5, .tick_clock = "virtual"};
+  int errors = 0;
+
+  printf("main: inicio\n");
+
+  ppos_init_config(&config);
+
+  task_init(&Pang, Body, NULL);
+  task_init(&Peng, Body, NULL);
+
+  errors += check(task_setdeadline(&Pang, 10, 3, 0) < 0, "classe EDF recusada");
+  errors += check(task_getclass(&Pang) == SCHED_CLASS_NORMAL, "Pang continua na classe normal");
+
+  task_wait(&Pang);
+  task_wait(&Peng);
+
+  printf("main: Pang %u ativações, %u extensões; Peng %u ativações, %u extensões\n",
+         Pang.activations, Pang.cs_extensions, Peng.activations, Peng.cs_extensions);
+  errors += check(Pang.activations > 2 && Peng.activations > 2, "tarefas se revezam");
+  errors += check(Pang.cs_extensions == 0 && Peng.cs_extensions == 0,
+                  "seções críticas sem extensão");
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
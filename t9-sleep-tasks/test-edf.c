@@ -0,0 +1,67 @@
+// PingPongOS - PingPong Operating System
+
+// Teste da classe EDF: a admissão rejeita reservas que passariam do limite
+// de utilização da classe, e tarefas admitidas que esgotam o orçamento a
+// cada período são apenas contidas (throttled), sem prazos perdidos.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define RUNTIME 500 // duração do teste (ms)
+
+task_t Pang, Peng, Ping;
+
+// processa sem parar: o orçamento se esgota em todos os períodos
+void Body(void *arg)
+{
+  while (systime() < RUNTIME)
+    ;
+  task_exit(0);
+}
+
+// confere uma condição do teste
+int check(int ok, const char *what)
+{
+  printf("main: %s (%s)\n", what, ok ? "ok" : "ERROR");
+  return !ok;
+}
+
+int main(int argc, char *argv[])
+{
+  int errors = 0;
+
+  printf("main: inicio\n");
+
+  ppos_init();
+
+  task_init(&Pang, Body, NULL);
+  task_init(&Peng, Body, NULL);
+  task_init(&Ping, Body, NULL);
+
+  // 30% + 20% cabem no limite da classe; mais 50% passaria dele
+  errors += check(task_setdeadline(&Pang, 10, 3, 0) == 0, "Pang admitida com 3/10 ms");
+  errors += check(task_setdeadline(&Peng, 20, 4, 0) == 0, "Peng admitida com 4/20 ms");
+  errors += check(task_setdeadline(&Ping, 10, 5, 0) < 0, "Ping rejeitada com 5/10 ms");
+  errors += check(task_getclass(&Ping) == SCHED_CLASS_NORMAL, "Ping continua na classe normal");
+
+  // orçamento e prazo inconsistentes
+  errors += check(task_setdeadline(&Ping, 10, 6, 5) < 0, "orçamento maior que o prazo rejeitado");
+
+  task_wait(&Pang);
+  task_wait(&Peng);
+  task_wait(&Ping);
+
+  printf("main: Pang %u prazos perdidos, %u contenções\n", Pang.deadline_misses, Pang.dl_throttles);
+  printf("main: Peng %u prazos perdidos, %u contenções\n", Peng.deadline_misses, Peng.dl_throttles);
+  errors += check(Pang.deadline_misses == 0 && Peng.deadline_misses == 0,
+                  "orçamentos esgotados não contam como prazos perdidos");
+  errors += check(Pang.dl_throttles >= RUNTIME / 10 / 2 && Peng.dl_throttles >= RUNTIME / 20 / 2,
+                  "orçamentos esgotados contados");
+  errors += check(Pang.throttles == Pang.dl_throttles && Pang.sleeps == 0,
+                  "contenções não contam como adormecimentos");
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
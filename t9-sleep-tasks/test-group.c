@@ -0,0 +1,79 @@
+// PingPongOS - PingPong Operating System
+
+// Teste do controle de banda por grupos: uma tarefa que processa sem parar,
+// num grupo com cota de 20 ms a cada 100 ms, deve ficar com cerca de 20% da
+// CPU, mesmo disputando com outra tarefa sem grupo; o grupo aninhado num
+// pai de cota menor fica limitado pela cota do pai.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define RUNTIME 1000   // duração da disputa (ms)
+#define TOLERANCE 0.05 // desvio máximo da fatia esperada (fração da CPU)
+
+task_t Pang, Peng, Ping;
+task_group_t limited, parent, child;
+
+// processa até o fim da disputa
+void Body(void *arg)
+{
+  while (systime() < RUNTIME)
+    ;
+  task_exit(0);
+}
+
+// confere a fatia de CPU obtida por uma tarefa
+int check(task_t *task, const char *name, double expected)
+{
+  double share = (double)task->processor_time / RUNTIME;
+  int ok = share >= expected - TOLERANCE && share <= expected + TOLERANCE;
+
+  printf("main: %s: cpu %5.2f%%, esperado %5.2f%% (%s)\n", name, 100 * share,
+         100 * expected, ok ? "ok" : "ERROR");
+  return !ok;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int throttled;
+  int errors = 0;
+
+  printf("main: inicio\n");
+
+  ppos_init();
+
+  group_init(&limited, NULL, 20, 100);
+  group_init(&parent, NULL, 10, 100);
+  group_init(&child, &parent, 50, 100);
+
+  task_init(&Pang, Body, NULL);
+  task_init(&Peng, Body, NULL);
+  task_init(&Ping, Body, NULL);
+  task_setgroup(&Pang, &limited);
+  task_setgroup(&Peng, &child);
+
+  task_wait(&Pang);
+  task_wait(&Peng);
+  task_wait(&Ping);
+
+  errors += check(&Pang, "Pang (cota 20/100)", 0.20);
+  errors += check(&Peng, "Peng (cota 50/100, pai 10/100)", 0.10);
+
+  // a cota esgotada deixa o grupo parado pelo resto de cada período
+  throttled = group_throttled_time(&limited);
+  printf("main: Pang parada %u ms, %u vezes (%s)\n", throttled, limited.throttle_count,
+         throttled >= RUNTIME * 4 / 10 ? "ok" : "ERROR");
+  if (throttled < RUNTIME * 4 / 10)
+    errors++;
+
+  // contenções não são adormecimentos
+  printf("main: Pang contida %u vezes, adormecida %u vezes (%s)\n", Pang.throttles, Pang.sleeps,
+         Pang.throttles > 0 && Pang.sleeps == 0 ? "ok" : "ERROR");
+  if (Pang.throttles == 0 || Pang.sleeps != 0)
+    errors++;
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
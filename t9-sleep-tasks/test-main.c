@@ -0,0 +1,63 @@
+// PingPongOS - PingPong Operating System
+
+// Teste da main preemptável: a main processa por várias fatias de tempo,
+// disputando a CPU com outra tarefa, e deve chegar ao fim. Se o dispatcher
+// a esquecer ao preemptá-la, o processo termina antes; o tratador de saída
+// acusa o erro.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define RUNTIME 300 // processamento da main (ms), muitas fatias de tempo
+
+task_t Worker;
+int finished = 0; // a main chegou ao fim
+
+// o processo terminou antes da main: falha
+void check_exit()
+{
+  if (!finished)
+  {
+    printf("main: processo terminou antes do fim da main (ERROR)\n");
+    _exit(1);
+  }
+}
+
+// processa por um tempo, como a main
+void Body(void *arg)
+{
+  while (systime() < RUNTIME / 2)
+    ;
+  printf("Worker: fim em %4d ms\n", systime());
+  task_exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+  volatile unsigned long i;
+  unsigned int start;
+
+  printf("main: inicio\n");
+  atexit(check_exit);
+
+  ppos_init();
+
+  // sozinha: a preempção não pode encerrar o sistema
+  start = systime();
+  while (systime() < start + RUNTIME / 2)
+    for (i = 0; i < 100000; i++)
+      ;
+
+  // com outra tarefa, que termina antes da main
+  task_init(&Worker, Body, NULL);
+  while (systime() < RUNTIME)
+    for (i = 0; i < 100000; i++)
+      ;
+
+  finished = 1;
+  printf("main: fim em %4d ms (ok)\n", systime());
+  task_exit(0);
+}
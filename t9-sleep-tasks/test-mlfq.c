@@ -0,0 +1,128 @@
+// PingPongOS - PingPong Operating System
+
+// Teste da política "mlfq": uma tarefa que processa sem parar esgota o
+// quantum de cada nível e desce até o último; depois, um fluxo contínuo de
+// tarefas curtas ocupa os níveis de cima, e só a elevação periódica devolve
+// a CPU à tarefa do último nível, que volta ao nível 0.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define LEVELS 4       // níveis (quanta de 2, 4, 8 e 16 ticks)
+#define QUANTUM 8      // quantum padrão (ticks): o do nível 0 é um quarto dele
+#define BOOST 100      // período da elevação (ticks)
+#define SOLO 50        // processamento da tarefa longa sozinha (ms)
+#define STREAM 600     // duração do fluxo de tarefas curtas (ms)
+#define INTERVAL 4     // intervalo entre tarefas curtas (ms)
+#define WORK 5         // processamento de cada tarefa curta (ms): nível 0 ou 1
+#define WORKERS (STREAM / INTERVAL)
+
+task_t Hog, workers[WORKERS];
+volatile int done = 0; // fim do teste para a tarefa longa
+int bottom = 0;        // a tarefa longa chegou ao último nível
+int restored = 0;      // vezes que ela voltou ao nível 0 depois disso
+long loops_per_ms;     // iterações de spin() por milissegundo
+int errors = 0;
+
+// processa por cerca de "ms" milissegundos de CPU, que não correm enquanto
+// a tarefa espera pela CPU
+void spin(long ms)
+{
+  volatile long i;
+
+  for (i = 0; i < ms * loops_per_ms; i++)
+    ;
+}
+
+// confere uma condição do teste
+void check(int ok, const char *what)
+{
+  printf("main: %s (%s)\n", what, ok ? "ok" : "ERROR");
+  if (!ok)
+    errors++;
+}
+
+// processa sem parar, acompanhando o próprio nível
+void HogBody(void *arg)
+{
+  int level = 0;
+
+  while (!done)
+  {
+    if (Hog.mlfq_level != level)
+    {
+      level = Hog.mlfq_level;
+      if (level == LEVELS - 1)
+        bottom = 1;
+      else if (level == 0 && bottom)
+        restored++;
+    }
+  }
+  task_exit(0);
+}
+
+// tarefa curta: termina antes de esgotar o quantum do nível 1
+void WorkerBody(void *arg)
+{
+  spin(WORK);
+  task_exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {
+      .sched_policy = "mlfq", .quantum = QUANTUM, .mlfq_levels = LEVELS, .mlfq_boost = BOOST};
+  mlfq_stats_t stats;
+  unsigned long long start;
+  int i, hog_before, hog_stream;
+
+  printf("main: inicio\n");
+
+  ppos_init_config(&config);
+
+  // calibra spin() enquanto main executa sozinha: mede 10^7 iterações
+  loops_per_ms = 1000000;
+  start = systime_us();
+  spin(10);
+  loops_per_ms = 10000000000LL / (systime_us() - start + 1) + 1;
+
+  // main, de tempo real, cria as tarefas sem disputar os níveis
+  task_setclass(NULL, SCHED_CLASS_FIFO);
+
+  // sozinha, a tarefa longa desce até o último nível
+  task_init(&Hog, HogBody, NULL);
+  task_sleep(SOLO);
+  ppos_mlfq_stats(&stats);
+  printf("main: Hog no nível %d, rebaixamentos %lu/%lu/%lu\n", Hog.mlfq_level,
+         stats.demotions[0], stats.demotions[1], stats.demotions[2]);
+  check(bottom && stats.demotions[0] > 0 && stats.demotions[1] > 0 && stats.demotions[2] > 0,
+        "tarefa longa rebaixada nível a nível até o último");
+  check(stats.quantum[0] == QUANTUM / 4 &&
+            stats.quantum[LEVELS - 1] == (QUANTUM / 4) << (LEVELS - 1),
+        "quantum dobra a cada nível");
+
+  // o fluxo de tarefas curtas pede mais CPU do que há nos níveis de cima
+  hog_before = Hog.processor_time;
+  for (i = 0; i < WORKERS; i++)
+  {
+    task_init(&workers[i], WorkerBody, NULL);
+    task_sleep(INTERVAL);
+  }
+  hog_stream = Hog.processor_time - hog_before;
+  ppos_mlfq_stats(&stats);
+
+  done = 1;
+  for (i = 0; i < WORKERS; i++)
+    task_wait(&workers[i]);
+  task_wait(&Hog);
+
+  printf("main: Hog %d ms de CPU durante o fluxo, %d voltas ao nível 0, %lu elevações\n",
+         hog_stream, restored, stats.boosts);
+  check(stats.boosts >= STREAM / BOOST / 2, "elevações periódicas");
+  check(restored > 0 && hog_stream > 0, "elevação devolve a CPU à tarefa do último nível");
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
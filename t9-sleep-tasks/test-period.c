@@ -0,0 +1,97 @@
+// PingPongOS - PingPong Operating System
+
+// Teste das tarefas periódicas: com trabalho curto, cada liberação é
+// atendida no seu instante, contado a partir da anterior, sem acumular
+// atraso; um trabalho que ultrapassa o período descarta as liberações
+// perdidas, que task_wait_period() retorna e as estatísticas contam.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define PERIOD 20    // período (ms)
+#define LIGHT 10     // liberações com trabalho curto, antes e depois do excesso
+#define OVERRUN 50   // duração do trabalho excessivo (ms)
+#define MAX_DRIFT 5  // atraso máximo aceito da última liberação (ms)
+
+task_t Pang;
+int errors = 0;
+
+// confere uma condição do teste
+void check(int ok, const char *what)
+{
+  printf("Pang: %s (%s)\n", what, ok ? "ok" : "ERROR");
+  if (!ok)
+    errors++;
+}
+
+// processa até o instante indicado
+void busy_until(unsigned long long t)
+{
+  while (systime_ns() < t)
+    ;
+}
+
+void Body(void *arg)
+{
+  unsigned long long start, now;
+  period_stats_t stats;
+  int i, missed = 0;
+
+  task_set_period(NULL, PERIOD * 1000);
+  start = Pang.next_release;
+
+  // trabalho curto: nenhuma liberação perdida e nenhum atraso acumulado
+  for (i = 0; i < LIGHT; i++)
+  {
+    busy_until(systime_ns() + PERIOD * 1000000ULL / 10);
+    missed += task_wait_period();
+  }
+  now = systime_ns();
+  check(missed == 0, "nenhuma liberação perdida com trabalho curto");
+  check(now >= start + LIGHT * PERIOD * 1000000ULL &&
+            now < start + (LIGHT * PERIOD + MAX_DRIFT) * 1000000ULL,
+        "liberações contadas a partir da anterior");
+
+  // trabalho excessivo: a liberação seguinte e a outra são perdidas
+  busy_until(Pang.next_release + OVERRUN * 1000000ULL);
+  missed = task_wait_period();
+  printf("Pang: %d liberações perdidas\n", missed);
+  check(missed == OVERRUN / PERIOD, "liberações perdidas retornadas");
+  check(Pang.next_release == start + (LIGHT + 1 + missed) * PERIOD * 1000000ULL,
+        "liberação seguinte mantida na grade do período");
+
+  // de volta ao trabalho curto
+  missed = 0;
+  for (i = 0; i < LIGHT; i++)
+    missed += task_wait_period();
+  check(missed == 0, "nenhuma liberação perdida após o excesso");
+
+  task_period_stats(NULL, &stats);
+  printf("Pang: período %ld us, %u liberações, %u perdidas, atraso médio %llu us, max %llu us\n",
+         stats.period_us, stats.releases, stats.overruns, stats.jitter_avg_ns / 1000,
+         stats.jitter_max_ns / 1000);
+  check(stats.period_us == PERIOD * 1000 && stats.releases == 2 * LIGHT + 1 &&
+            stats.overruns == OVERRUN / PERIOD,
+        "estatísticas periódicas");
+
+  // tarefa que não é periódica
+  task_set_period(NULL, 0);
+  check(task_wait_period() < 0, "task_wait_period sem período retorna erro");
+
+  task_exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+  printf("main: inicio\n");
+
+  ppos_init();
+
+  task_init(&Pang, Body, NULL);
+  task_wait(&Pang);
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
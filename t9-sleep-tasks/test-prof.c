@@ -0,0 +1,86 @@
+// PingPongOS - PingPong Operating System
+
+// Teste do perfil de CPU na pilha da main: a main processa dentro de uma
+// cadeia de chamadas (outer, middle, leaf) e, ao fim do processo, as
+// amostras dela devem trazer os quadros de quem chamou leaf, e não só o
+// ponto interrompido. A verificação lê o arquivo de amostras depois que o
+// núcleo o salva (ver ppos_prof.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define RUNTIME 300                 // processamento da main (ms)
+#define PROFILE "test-prof.samples" // arquivo de amostras
+#define MIN_DEPTH 4                 // leaf, middle, outer e main
+
+volatile unsigned long counter = 0;
+
+__attribute__((noinline)) void leaf()
+{
+  while (systime() < RUNTIME)
+    counter++;
+}
+
+__attribute__((noinline)) void middle()
+{
+  leaf();
+}
+
+__attribute__((noinline)) void outer()
+{
+  middle();
+}
+
+// chamada após o núcleo salvar as amostras: conta as da main com a pilha
+// completa
+void check_profile()
+{
+  char line[4096], *frame;
+  int samples = 0, deep = 0, depth;
+  FILE *file;
+
+  if ((file = fopen(PROFILE, "r")) == NULL)
+  {
+    printf("main: arquivo de amostras ausente (ERROR)\n");
+    _exit(1);
+  }
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    if (strncmp(line, "sample 0 ", 9) != 0)
+      continue;
+    samples++;
+    depth = 0;
+    for (frame = strtok(line + 9, " \n"); frame != NULL; frame = strtok(NULL, " \n"))
+      depth++;
+    if (depth >= MIN_DEPTH)
+      deep++;
+  }
+  fclose(file);
+  unlink(PROFILE);
+
+  // algumas amostras podem cair no tratador de ticks ou em systime()
+  printf("main: %d amostras, %d com ao menos %d quadros (%s)\n", samples, deep, MIN_DEPTH,
+         samples > 0 && deep * 2 >= samples ? "ok" : "ERROR");
+  if (samples == 0 || deep * 2 < samples)
+    _exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {.profile_file = PROFILE};
+
+  printf("main: inicio\n");
+
+  // registrada antes de ppos_init_config: executa depois da gravação
+  atexit(check_profile);
+  ppos_init_config(&config);
+
+  outer();
+
+  printf("main: fim\n");
+  task_exit(0);
+}
@@ -0,0 +1,69 @@
+// PingPongOS - PingPong Operating System
+
+// Teste do ajuste automático do quantum: com latência alvo de 40 ms, cada
+// uma das N tarefas prontas (inclusive a que vai executar) deve receber
+// 40/N ms. Duas e depois quatro tarefas processam sem parar, e uma delas
+// consulta o quantum no meio de cada disputa.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define LATENCY 40 // latência alvo (ms)
+#define PHASE 300  // duração de cada disputa (ms)
+#define MAX_TASKS 4
+
+task_t tasks[MAX_TASKS];
+unsigned int phase_end; // fim da disputa atual (ms)
+int observed;           // quantum visto no meio da disputa (ticks)
+
+// processa até o fim da disputa; a primeira tarefa consulta o quantum
+void Body(void *arg)
+{
+  quantum_stats_t stats;
+  int first = (arg != NULL);
+
+  while (systime() < phase_end - PHASE / 2)
+    ;
+  if (first)
+  {
+    ppos_quantum_stats(&stats);
+    observed = stats.quantum;
+  }
+  while (systime() < phase_end)
+    ;
+  task_exit(0);
+}
+
+// disputa entre n tarefas; retorna 1 se o quantum não for LATENCY/n
+int contest(int n)
+{
+  int i, expected = LATENCY / n;
+
+  phase_end = systime() + PHASE;
+  for (i = 0; i < n; i++)
+    task_init(&tasks[i], Body, i == 0 ? &tasks[i] : NULL);
+  for (i = 0; i < n; i++)
+    task_wait(&tasks[i]);
+
+  printf("main: %d tarefas prontas: quantum %d ticks, esperado %d (%s)\n", n, observed,
+         expected, observed == expected ? "ok" : "ERROR");
+  return observed != expected;
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {.target_latency = LATENCY, .min_granularity = 1};
+  int errors = 0;
+
+  printf("main: inicio\n");
+
+  ppos_init_config(&config);
+
+  errors += contest(2);
+  errors += contest(4);
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
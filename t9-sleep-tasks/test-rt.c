@@ -0,0 +1,132 @@
+// PingPongOS - PingPong Operating System
+
+// Teste da classe de tempo real: tarefas FIFO e RR tomam a CPU de uma tarefa
+// normal assim que ficam prontas; uma tarefa FIFO executa até terminar, sem
+// ceder a CPU a outra de mesma prioridade; tarefas RR se revezam, cada uma
+// com o próprio quantum (task_setquantum), e dividem a CPU na proporção dos
+// quanta.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define FIFO_START 20  // instante em que as tarefas FIFO acordam (ms)
+#define FIFO_RUN 50    // processamento de cada tarefa FIFO (ms)
+#define RR_START 200   // instante em que as tarefas RR acordam (ms)
+#define RR_END 500     // fim da disputa entre as tarefas RR (ms)
+#define QUANTUM_A 5    // quantum de RrA (ticks)
+#define QUANTUM_B 20   // quantum de RrB (ticks)
+#define MAX_LATENCY 3  // atraso máximo para a tarefa de tempo real executar (ms)
+#define TOLERANCE 0.05 // desvio máximo da fatia esperada (fração da CPU)
+
+task_t Norm, Fifo1, Fifo2, RrA, RrB;
+volatile int done = 0;           // fim do teste para a tarefa normal
+volatile unsigned long progress; // processamento da tarefa normal
+int errors = 0;
+
+// intervalo de execução de uma tarefa FIFO
+typedef struct
+{
+  unsigned int start, end;
+  unsigned long progress; // processamento da tarefa normal no intervalo
+} run_t;
+
+run_t run1, run2;
+unsigned long rr_progress[2]; // processamento da tarefa normal no início e fim das RR
+
+// confere uma condição do teste
+void check(int ok, const char *what)
+{
+  printf("main: %s (%s)\n", what, ok ? "ok" : "ERROR");
+  if (!ok)
+    errors++;
+}
+
+// tarefa normal: processa até o fim do teste
+void NormBody(void *arg)
+{
+  while (!done)
+    progress++;
+  task_exit(0);
+}
+
+// acorda em FIFO_START e processa FIFO_RUN ms sem ceder a CPU
+void FifoBody(void *arg)
+{
+  run_t *run = arg;
+  unsigned long start_progress;
+
+  task_sleep(FIFO_START);
+  run->start = systime();
+  start_progress = progress;
+  while (systime() < run->start + FIFO_RUN)
+    ;
+  run->progress = progress - start_progress;
+  run->end = systime();
+  task_exit(0);
+}
+
+// acorda em RR_START e processa até RR_END
+void RrBody(void *arg)
+{
+  task_sleep(RR_START);
+  if (rr_progress[0] == 0)
+    rr_progress[0] = progress;
+  while (systime() < RR_END)
+    ;
+  rr_progress[1] = progress;
+  task_exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+  double share;
+
+  printf("main: inicio\n");
+
+  ppos_init();
+
+  task_init(&Norm, NormBody, NULL);
+  task_init(&Fifo1, FifoBody, &run1);
+  task_init(&Fifo2, FifoBody, &run2);
+  task_init(&RrA, RrBody, NULL);
+  task_init(&RrB, RrBody, NULL);
+  task_setclass(&Fifo1, SCHED_CLASS_FIFO);
+  task_setclass(&Fifo2, SCHED_CLASS_FIFO);
+  task_setquantum(&RrA, QUANTUM_A);
+  task_setquantum(&RrB, QUANTUM_B);
+  task_setclass(&RrA, SCHED_CLASS_RR);
+  task_setclass(&RrB, SCHED_CLASS_RR);
+
+  task_wait(&Fifo1);
+  task_wait(&Fifo2);
+  task_wait(&RrA);
+  task_wait(&RrB);
+  done = 1;
+  task_wait(&Norm);
+
+  // FIFO: toma a CPU da tarefa normal e só a devolve ao terminar
+  printf("main: Fifo1 %u-%u ms, Fifo2 %u-%u ms\n", run1.start, run1.end, run2.start, run2.end);
+  check(run1.start < FIFO_START + MAX_LATENCY || run2.start < FIFO_START + MAX_LATENCY,
+        "tarefa FIFO executa assim que acorda");
+  check(run1.progress == 0 && run2.progress == 0,
+        "tarefa normal não executa durante as tarefas FIFO");
+  check(run1.end <= run2.start || run2.end <= run1.start,
+        "tarefa FIFO executa até terminar");
+
+  // RR: revezamento na proporção dos quanta
+  share = (double)RrA.processor_time / (RrA.processor_time + RrB.processor_time);
+  printf("main: RrA %d ms em %u ativações, RrB %d ms em %u ativações\n",
+         RrA.processor_time, RrA.activations, RrB.processor_time, RrB.activations);
+  check(task_getquantum(&RrA) == QUANTUM_A && task_getquantum(&RrB) == QUANTUM_B,
+        "quanta das tarefas RR");
+  check(share >= (double)QUANTUM_A / (QUANTUM_A + QUANTUM_B) - TOLERANCE &&
+            share <= (double)QUANTUM_A / (QUANTUM_A + QUANTUM_B) + TOLERANCE,
+        "tarefas RR dividem a CPU na proporção dos quanta");
+  check(RrA.activations > 5 && RrB.activations > 5, "tarefas RR se revezam");
+  check(rr_progress[1] == rr_progress[0], "tarefa normal não executa durante as tarefas RR");
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
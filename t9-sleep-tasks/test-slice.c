@@ -0,0 +1,154 @@
+// PingPongOS - PingPong Operating System
+
+// Teste da extensão da fatia de tempo: uma tarefa que passa metade do tempo
+// em seções críticas curtas não deve ser vista dentro delas por outra
+// tarefa, a não ser quando ultrapassa a extensão (abuso); uma tarefa com
+// seções críticas longas sofre a preempção forçada, e os abusos são contados;
+// uma tarefa que liga e desliga cs_flag diretamente, sem task_cs_end(), é
+// preemptada ao fim da extensão sem que isso conte como abuso.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define RUNTIME 500   // duração do teste (ms)
+#define SHORT_CS 20   // duração das seções críticas curtas (us)
+#define LONG_CS 5     // duração das seções críticas longas (ms)
+#define LONG_ROUNDS 5 // seções críticas longas
+#define FLAG_CS 300   // duração das seções críticas marcadas em cs_flag (us)
+#define FLAG_GAP 2000 // intervalo entre elas, maior que a extensão (us)
+
+task_t Pang, Peng, Ping, Pung;
+volatile int inside = 0;           // Pang está em seção crítica
+volatile unsigned int serial = 0;  // seção crítica atual de Pang
+unsigned int seen = 0;             // seções críticas de Pang vistas por Peng
+long loops_per_us;                 // iterações de spin() por microssegundo
+
+// processa pelo tempo indicado (us)
+void busy(unsigned long long us)
+{
+  unsigned long long end = systime_us() + us;
+
+  while (systime_us() < end)
+    ;
+}
+
+// processa por cerca de "us" microssegundos de CPU, que não correm enquanto
+// a tarefa espera pela CPU (ao contrário de busy())
+void spin(long us)
+{
+  volatile long i;
+
+  for (i = 0; i < us * loops_per_us; i++)
+    ;
+}
+
+// seções críticas curtas, alternadas com processamento fora delas
+void ShortBody(void *arg)
+{
+  while (systime() < RUNTIME)
+  {
+    task_cs_begin();
+    serial++;
+    inside = 1;
+    busy(SHORT_CS);
+    inside = 0;
+    task_cs_end();
+    busy(SHORT_CS);
+  }
+  task_exit(0);
+}
+
+// conta as seções críticas de Pang em que ela perdeu a CPU
+void Observer(void *arg)
+{
+  unsigned int last = 0;
+
+  while (systime() < RUNTIME)
+  {
+    if (inside && serial != last)
+    {
+      last = serial;
+      seen++;
+    }
+  }
+  task_exit(0);
+}
+
+// seções críticas longas demais para a extensão
+void LongBody(void *arg)
+{
+  int i;
+
+  for (i = 0; i < LONG_ROUNDS; i++)
+  {
+    task_cs_begin();
+    busy(LONG_CS * 1000);
+    task_cs_end();
+  }
+  task_exit(0);
+}
+
+// seções críticas marcadas diretamente em cs_flag, separadas por mais de
+// um tick fora delas: a extensão termina com a tarefa já fora da seção
+void FlagBody(void *arg)
+{
+  while (systime() < RUNTIME)
+  {
+    Pung.cs_flag = 1;
+    spin(FLAG_CS);
+    Pung.cs_flag = 0;
+    spin(FLAG_GAP);
+  }
+  task_exit(0);
+}
+
+// confere uma condição do teste
+int check(int ok, const char *what)
+{
+  printf("main: %s (%s)\n", what, ok ? "ok" : "ERROR");
+  return !ok;
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {.quantum = 1}; // fatias curtas: muitas acabam em seção crítica
+  unsigned long long start;
+  int errors = 0;
+
+  printf("main: inicio\n");
+
+  ppos_init_config(&config);
+
+  // calibra spin() enquanto main executa sozinha: mede 10^7 iterações
+  loops_per_us = 1000;
+  start = systime_us();
+  spin(10000);
+  loops_per_us = 10000000 / (systime_us() - start + 1) + 1;
+
+  task_init(&Pang, ShortBody, NULL);
+  task_init(&Peng, Observer, NULL);
+  task_init(&Ping, LongBody, NULL);
+  task_init(&Pung, FlagBody, NULL);
+
+  task_wait(&Pang);
+  task_wait(&Peng);
+  task_wait(&Ping);
+  task_wait(&Pung);
+
+  printf("main: Pang: %u seções críticas, %u extensões, %u abusos, %u vistas por Peng\n",
+         serial, Pang.cs_extensions, Pang.cs_abuses, seen);
+  printf("main: Ping: %u extensões, %u abusos\n", Ping.cs_extensions, Ping.cs_abuses);
+  printf("main: Pung: %u extensões, %u abusos\n", Pung.cs_extensions, Pung.cs_abuses);
+  errors += check(Pang.cs_extensions > 0, "extensões concedidas às seções críticas curtas");
+  errors += check(seen <= Pang.cs_abuses, "seções críticas curtas preemptadas só por abuso");
+  errors += check(Ping.cs_abuses >= LONG_ROUNDS, "seções críticas longas preemptadas");
+  // sem a correção, toda extensão terminaria em abuso; sobram só os sinais
+  // de tick atrasados pelo hospedeiro
+  errors += check(Pung.cs_extensions > 0 && Pung.cs_abuses < Pung.cs_extensions / 2,
+                  "cs_flag desligado diretamente não conta como abuso");
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
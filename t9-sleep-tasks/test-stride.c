@@ -0,0 +1,84 @@
+// PingPongOS - PingPong Operating System
+
+// Teste da política "stride": tarefas com bilhetes na proporção 3:2:1
+// disputam a CPU por 10 s; a fatia de CPU obtida por cada uma deve ficar a
+// menos de 1% da fatia definida pelos bilhetes
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define RUNTIME 10000  // duração da disputa (ms)
+#define TOLERANCE 0.01 // desvio máximo da fatia esperada (fração da CPU)
+
+task_t Pang, Peng, Ping;
+
+int tickets[3] = {300, 200, 100};
+
+// simula um processamento pesado
+int hardwork(int n)
+{
+  int i, j, soma;
+
+  soma = 0;
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+      soma += j;
+  return (soma);
+}
+
+// corpo das threads: processa até o fim da disputa
+void Body(void *arg)
+{
+  printf("%s: inicio em %5d ms (bilhetes: %d)\n", (char *)arg,
+         systime(), task_gettickets(NULL));
+  while (systime() < RUNTIME)
+    hardwork(100);
+  printf("%s: fim    em %5d ms\n", (char *)arg, systime());
+  task_exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {.sched_policy = "stride"};
+  task_t *tasks[3] = {&Pang, &Peng, &Ping};
+  char *names[3] = {"    Pang", "        Peng", "            Ping"};
+  unsigned int total_cpu = 0;
+  int i, ok, total_tickets = 0, errors = 0;
+  double share, expected;
+
+  printf("main: inicio\n");
+
+  ppos_init_config(&config);
+
+  for (i = 0; i < 3; i++)
+  {
+    task_init(tasks[i], Body, names[i]);
+    task_settickets(tasks[i], tickets[i]);
+  }
+
+  for (i = 0; i < 3; i++)
+    task_wait(tasks[i]);
+
+  for (i = 0; i < 3; i++)
+  {
+    total_cpu += tasks[i]->processor_time;
+    total_tickets += tickets[i];
+  }
+
+  // compara a fatia de CPU de cada tarefa com a fatia dada pelos bilhetes
+  for (i = 0; i < 3; i++)
+  {
+    share = (double)tasks[i]->processor_time / total_cpu;
+    expected = (double)tickets[i] / total_tickets;
+    ok = (share >= expected - TOLERANCE && share <= expected + TOLERANCE);
+    if (!ok)
+      errors++;
+    printf("main: tarefa %d (%3d bilhetes): cpu %5.2f%%, esperado %5.2f%% (%s)\n",
+           tasks[i]->id, tickets[i], 100 * share, 100 * expected, ok ? "ok" : "ERROR");
+  }
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
@@ -0,0 +1,235 @@
+// PingPongOS - PingPong Operating System
+
+// Teste dos semáforos, dos mutexes e das estatísticas de contenção:
+// produtores e consumidores trocam itens por um buffer limitado, protegido
+// por um mutex, e ao fim os itens consumidos e as aquisições contadas devem
+// bater com os produzidos; uma tarefa bloqueada num semáforo destruído deve
+// receber erro; as esperas com prazo devem expirar sem deixar rastro no
+// semáforo ou no mutex, mesmo que o semáforo seja liberado antes de a tarefa
+// que desistiu voltar a executar.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define PRODUCERS 3
+#define CONSUMERS 2
+#define ITEMS 60    // itens por produtor
+#define BUFSIZE 5   // posições do buffer
+
+task_t producers[PRODUCERS], consumers[CONSUMERS], waiter, holder, quitter, racer;
+semaphore_t s_free, s_items, s_never, s_timed;
+mutex_t m_buffer, m_timed;
+int buffer[BUFSIZE], head = 0, tail = 0;
+long produced = 0, consumed = 0;
+int waiter_result = 0, racer_result = 0;
+
+// simula um processamento, para que haja preempção dentro das seções críticas
+void hardwork(int n)
+{
+  volatile int i;
+
+  for (i = 0; i < n; i++)
+    ;
+}
+
+void Producer(void *arg)
+{
+  int i, item;
+
+  for (i = 0; i < ITEMS; i++)
+  {
+    item = task_id() * 1000 + i;
+    sem_down(&s_free);
+    mutex_lock(&m_buffer);
+    buffer[tail] = item;
+    tail = (tail + 1) % BUFSIZE;
+    produced += item;
+    hardwork(1000000);
+    mutex_unlock(&m_buffer);
+    sem_up(&s_items);
+  }
+  task_exit(0);
+}
+
+void Consumer(void *arg)
+{
+  int i, item;
+
+  for (i = 0; i < PRODUCERS * ITEMS / CONSUMERS; i++)
+  {
+    sem_down(&s_items);
+    mutex_lock(&m_buffer);
+    item = buffer[head];
+    head = (head + 1) % BUFSIZE;
+    consumed += item;
+    hardwork(1000000);
+    mutex_unlock(&m_buffer);
+    sem_up(&s_free);
+  }
+  task_exit(0);
+}
+
+// bloqueia num semáforo que nunca é liberado, apenas destruído
+void Waiter(void *arg)
+{
+  waiter_result = sem_down(&s_never);
+  task_exit(0);
+}
+
+// detém o mutex por um tempo
+void Holder(void *arg)
+{
+  mutex_lock(&m_timed);
+  task_sleep(200);
+  mutex_unlock(&m_timed);
+  task_exit(0);
+}
+
+// desiste de esperar pelo semáforo
+void Quitter(void *arg)
+{
+  sem_down_timeout(&s_timed, 50);
+  task_exit(0);
+}
+
+// tarefa FIFO: assim que Quitter desiste, e antes que ela volte a executar,
+// libera o semáforo e o requisita de novo, o que não deve bloquear
+void Racer(void *arg)
+{
+  task_sleep(10);
+  while (!quitter.timed_out)
+    ;
+  sem_up(&s_timed);
+  racer_result = sem_down_timeout(&s_timed, 500);
+  task_exit(0);
+}
+
+// confere uma condição do teste
+int check(int ok, const char *what)
+{
+  printf("main: %s (%s)\n", what, ok ? "ok" : "ERROR");
+  return !ok;
+}
+
+// esperas com prazo em semáforo e mutex
+int test_timeouts()
+{
+  unsigned int start;
+  int errors = 0, result;
+
+  sem_init(&s_timed, 0);
+  mutex_init(&m_timed);
+
+  // o prazo expira e a requisição é desfeita
+  start = systime();
+  result = sem_down_timeout(&s_timed, 50);
+  errors += check(result == PPOS_ETIMEDOUT && systime() - start >= 50,
+                  "sem_down_timeout expira após o prazo");
+  errors += check(s_timed.value == 0 && s_timed.queue == NULL,
+                  "semáforo intacto após a expiração");
+
+  // prazo nulo: só adquire o que está disponível
+  sem_up(&s_timed);
+  errors += check(sem_down_timeout(&s_timed, 0) == 0,
+                  "sem_down_timeout(0) adquire o disponível");
+  errors += check(sem_down_timeout(&s_timed, 0) == PPOS_ETIMEDOUT,
+                  "sem_down_timeout(0) não bloqueia");
+
+  // mutex ocupado por outra tarefa: expira, depois espera a entrega
+  task_init(&holder, Holder, NULL);
+  task_sleep(10);
+  start = systime();
+  errors += check(mutex_lock_timeout(&m_timed, 50) == PPOS_ETIMEDOUT &&
+                      systime() - start >= 50,
+                  "mutex_lock_timeout expira com o mutex ocupado");
+  errors += check(m_timed.queue == NULL && m_timed.owner == holder.id,
+                  "mutex continua com a dona após a expiração");
+  errors += check(mutex_lock_timeout(&m_timed, 1000) == 0 && m_timed.owner == task_id(),
+                  "mutex_lock_timeout adquire quando o mutex é entregue");
+  errors += check(mutex_unlock(&m_timed) == 0 && !m_timed.locked, "mutex liberado");
+  task_wait(&holder);
+
+  // liberação entre a expiração do prazo e o retorno de quem desistiu
+  task_init(&quitter, Quitter, NULL);
+  task_init(&racer, Racer, NULL);
+  task_setclass(&racer, SCHED_CLASS_FIFO);
+  task_wait(&racer);
+  task_wait(&quitter);
+  errors += check(racer_result == 0 && s_timed.value == 0 && s_timed.queue == NULL,
+                  "sem_up após a expiração não se perde");
+
+  sem_destroy(&s_timed);
+  mutex_destroy(&m_timed);
+  return errors;
+}
+
+int main(int argc, char *argv[])
+{
+  ppos_config_t config = {.quantum = 1}; // preempção frequente: disputa pelo mutex
+  lock_stats_t stats;
+  int i, errors = 0;
+
+  printf("main: inicio\n");
+
+  // estatísticas ligadas; o relatório só é guardado se PPOS_LOCKSTAT pedir
+  if (getenv("PPOS_LOCKSTAT") == NULL)
+    config.lockstat_file = "/dev/null";
+  ppos_init_config(&config);
+
+  sem_init(&s_free, BUFSIZE);
+  sem_init(&s_items, 0);
+  sem_init(&s_never, 0);
+  mutex_init(&m_buffer);
+  sem_setname(&s_free, "s_free");
+  sem_setname(&s_items, "s_items");
+  sem_setname(&s_never, "s_never");
+  mutex_setname(&m_buffer, "m_buffer");
+
+  task_init(&waiter, Waiter, NULL);
+  for (i = 0; i < PRODUCERS; i++)
+    task_init(&producers[i], Producer, NULL);
+  for (i = 0; i < CONSUMERS; i++)
+    task_init(&consumers[i], Consumer, NULL);
+
+  for (i = 0; i < PRODUCERS; i++)
+    task_wait(&producers[i]);
+  for (i = 0; i < CONSUMERS; i++)
+    task_wait(&consumers[i]);
+
+  sem_destroy(&s_never);
+  task_wait(&waiter);
+
+  printf("main: produzido %ld, consumido %ld (%s)\n", produced, consumed,
+         produced == consumed ? "ok" : "ERROR");
+  if (produced != consumed)
+    errors++;
+
+  printf("main: sem_down em semáforo destruído retornou %d (%s)\n", waiter_result,
+         waiter_result < 0 ? "ok" : "ERROR");
+  if (waiter_result >= 0)
+    errors++;
+
+  errors += test_timeouts();
+
+  mutex_getstats(&m_buffer, &stats);
+  printf("main: %s: %lu aquisições, %lu com espera (max %llu us), posse max %llu us (%s)\n",
+         stats.name, stats.acquisitions, stats.contended, stats.wait_max / 1000,
+         stats.hold_max / 1000,
+         stats.acquisitions == 2 * PRODUCERS * ITEMS ? "ok" : "ERROR");
+  if (stats.acquisitions != 2 * PRODUCERS * ITEMS)
+    errors++;
+
+  sem_getstats(&s_items, &stats);
+  printf("main: %s: %lu aquisições, %lu com espera (%s)\n", stats.name, stats.acquisitions,
+         stats.contended,
+         stats.acquisitions == PRODUCERS * ITEMS && stats.contended <= stats.acquisitions
+             ? "ok"
+             : "ERROR");
+  if (stats.acquisitions != PRODUCERS * ITEMS || stats.contended > stats.acquisitions)
+    errors++;
+
+  printf("main: fim\n");
+  task_exit(errors);
+}
@@ -0,0 +1,109 @@
+// PingPongOS - PingPong Operating System
+
+// Teste dos temporizadores do núcleo e das esperas com prazo: um temporizador
+// armado vence uma única vez, depois do prazo, e um cancelado não vence;
+// task_suspend_timeout() retorna PPOS_ETIMEDOUT quando o prazo expira, já
+// fora da fila, e 0 quando a tarefa é acordada antes; task_wait_timeout()
+// desiste de uma tarefa que demora a terminar, e entrega à parte o código de
+// saída, mesmo que ele seja igual a PPOS_ETIMEDOUT.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppos.h"
+#include "ppos_ext.h"
+
+#define TIMEOUT 30 // prazo das esperas (ms)
+
+task_t waker, sleeper;
+task_t *queue = NULL;
+ktimer_t alarm_timer;
+int fired = 0;             // vezes que o temporizador venceu
+unsigned int fired_at = 0; // instante do último vencimento (ms)
+
+// chamada pelo temporizador ao vencer
+void expired(ktimer_t *t, void *arg)
+{
+  fired++;
+  fired_at = systime();
+}
+
+// acorda a tarefa que espera na fila
+void Waker(void *arg)
+{
+  task_sleep(TIMEOUT / 2);
+  task_awake(queue, &queue);
+  task_exit(0);
+}
+
+// demora a terminar
+void Sleeper(void *arg)
+{
+  task_sleep(4 * TIMEOUT);
+  task_exit(PPOS_ETIMEDOUT);
+}
+
+// confere uma condição do teste
+int check(int ok, const char *what)
+{
+  printf("main: %s (%s)\n", what, ok ? "ok" : "ERROR");
+  return !ok;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int start;
+  int errors = 0, result, exit_code;
+
+  printf("main: inicio\n");
+
+  ppos_init();
+
+  // temporizador vence uma vez, depois do prazo
+  ktimer_init(&alarm_timer, expired, NULL);
+  start = systime();
+  errors += check(ktimer_arm(&alarm_timer, TIMEOUT) == 0, "temporizador armado");
+  task_sleep(2 * TIMEOUT);
+  errors += check(fired == 1 && fired_at - start >= TIMEOUT, "temporizador vence após o prazo");
+  errors += check(ktimer_cancel(&alarm_timer) == 0, "temporizador vencido já está desarmado");
+
+  // temporizador cancelado não vence
+  ktimer_arm(&alarm_timer, TIMEOUT);
+  errors += check(ktimer_cancel(&alarm_timer) == 1, "temporizador armado cancelado");
+  task_sleep(2 * TIMEOUT);
+  errors += check(fired == 1, "temporizador cancelado não vence");
+
+  // prazo expirado: a tarefa retorna já fora da fila
+  start = systime();
+  result = task_suspend_timeout(&queue, TIMEOUT);
+  errors += check(result == PPOS_ETIMEDOUT && systime() - start >= TIMEOUT,
+                  "task_suspend_timeout expira após o prazo");
+  errors += check(queue == NULL, "fila vazia após a expiração");
+
+  // prazo nulo: não bloqueia
+  errors += check(task_suspend_timeout(&queue, 0) == PPOS_ETIMEDOUT && queue == NULL,
+                  "task_suspend_timeout(0) não bloqueia");
+
+  // acordada antes do prazo
+  task_init(&waker, Waker, NULL);
+  start = systime();
+  result = task_suspend_timeout(&queue, 10 * TIMEOUT);
+  errors += check(result == 0 && systime() - start < 10 * TIMEOUT,
+                  "task_suspend_timeout acordada antes do prazo");
+  task_wait(&waker);
+
+  // espera com prazo pelo fim de outra tarefa, cujo código de saída é o
+  // mesmo valor de PPOS_ETIMEDOUT
+  task_init(&sleeper, Sleeper, NULL);
+  exit_code = 0;
+  errors += check(task_wait_timeout(&sleeper, TIMEOUT, &exit_code) == PPOS_ETIMEDOUT &&
+                      exit_code == 0,
+                  "task_wait_timeout expira antes do fim da tarefa");
+  errors += check(task_wait_timeout(&sleeper, -1, &exit_code) == 0 &&
+                      exit_code == PPOS_ETIMEDOUT,
+                  "task_wait_timeout sem prazo entrega o código de saída");
+  errors += check(task_wait_timeout(&sleeper, 0, NULL) == 0,
+                  "task_wait_timeout de tarefa já encerrada");
+
+  printf("main: fim\n");
+  task_exit(errors);
+}